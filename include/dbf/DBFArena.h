@@ -0,0 +1,47 @@
+#ifndef DBF_ARENA_H
+#define DBF_ARENA_H
+
+#include <cstddef>
+#include <memory>
+
+#include <boost/container/pmr/global_resource.hpp>
+#include <boost/container/pmr/memory_resource.hpp>
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+#include <boost/container/pmr/vector.hpp>
+
+namespace dbf {
+// C++14ûstd::pmrýӿͬboost::container::pmrC++17ʱֻ
+namespace pmr = boost::container::pmr;
+
+/**
+ * @brief  ڴأֻƶָ룬ͷǿղreset()һԻȫڴ档
+ *         ʱԤһʼڴ棬resetڴ¿ʼʼڴ湻ʱ
+ *         һѯڲٷȫֶѡ̰߳ȫÿ̸߳һ
+ *         resetǰٴĶDBFBufferRecordBatchȣ
+ */
+class DBFArena {
+public:
+  explicit DBFArena(size_t initialBytes = kDefaultInitialBytes,
+                    pmr::memory_resource *upstream = pmr::new_delete_resource())
+      : initial_(new char[initialBytes]),
+        resource_(initial_.get(), initialBytes, upstream) {}
+
+  DBFArena(const DBFArena &) = delete;
+  DBFArena &operator=(const DBFArena &) = delete;
+
+public:
+  pmr::memory_resource *resource() { return &resource_; }
+
+  void reset() { resource_.release(); }
+
+private:
+  static const size_t kDefaultInitialBytes = 4 * 1024 * 1024;
+
+private:
+  std::unique_ptr<char[]> initial_;
+  pmr::monotonic_buffer_resource resource_;
+};
+} // namespace dbf
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef DBF_ASYNC_WRITER_H
+#define DBF_ASYNC_WRITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dbf {
+class DBFBuffer;
+class DBFFile;
+class DBFRecord;
+
+class DBFAsyncWriter {
+public:
+  enum FsyncPolicy { kFsyncNever, kFsyncInterval, kFsyncRecords };
+
+public:
+  explicit DBFAsyncWriter(DBFFile &file, FsyncPolicy policy = kFsyncNever,
+                          size_t every = 0,
+                          size_t maxPendingBytes = kMaxPendingBytes);
+  ~DBFAsyncWriter();
+
+  DBFAsyncWriter(const DBFAsyncWriter &) = delete;
+  DBFAsyncWriter &operator=(const DBFAsyncWriter &) = delete;
+
+public:
+  bool start();
+  bool stop();
+  bool flush();
+
+  bool appendWriten(const DBFRecord &record);
+  bool appendWriten(const std::shared_ptr<DBFRecord> &record);
+  bool appendWriten(const std::list<std::shared_ptr<DBFRecord>> &records);
+  bool overWriten(const DBFRecord &record);
+  bool overWriten(const std::shared_ptr<DBFRecord> &record);
+  bool overWriten(const std::list<std::shared_ptr<DBFRecord>> &records);
+
+  bool good() const;
+  bool running() const { return thread_.joinable(); }
+
+private:
+  struct Group {
+    struct Mark {
+      size_t appendBytes;
+      size_t patchBytes;
+      size_t patchCount;
+      size_t appendRecords;
+      size_t items;
+    };
+
+    Group();
+
+    bool empty() const { return items == 0; }
+    size_t bytes() const;
+    void clear();
+    Mark mark() const;
+    void rollback(const Mark &mark);
+
+    std::unique_ptr<DBFBuffer> appendBuf;
+    std::unique_ptr<DBFBuffer> patchBuf;
+    std::vector<size_t> patchPos;
+    size_t appendRecords;
+    size_t items;
+  };
+
+  void run();
+  bool waitWritable(std::unique_lock<std::mutex> &lock);
+  size_t enqueueAppend(const DBFRecord &record);
+  void enqueuePatch(const DBFRecord &record);
+  bool writeGroup(Group &group);
+  bool syncIfDue(size_t records, bool force);
+
+private:
+  DBFFile &file_;
+  FsyncPolicy policy_;
+  size_t every_;
+  size_t maxPendingBytes_;
+  size_t recordBytes_;
+  size_t tail_;
+  bool session_;
+  size_t writingBytes_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable wakeup_;
+  std::condition_variable notFull_;
+  std::condition_variable flushed_;
+  std::thread thread_;
+  Group front_;
+  Group back_;
+  uint64_t enqueued_;
+  uint64_t written_;
+  bool stopping_;
+  bool failed_;
+
+  size_t unsynced_;
+  std::chrono::steady_clock::time_point lastSync_;
+
+private:
+  static const size_t kMaxPendingBytes = 64 * 1024 * 1024;
+  static const char kEndFileFlag = 0x1A;
+};
+} // namespace dbf
+
+#endif // !DBF_ASYNC_WRITER_H
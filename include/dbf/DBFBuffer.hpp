@@ -10,23 +10,71 @@
 #include <array>
 #include <sstream>
 #include <exception>
+#include <stdexcept>
+#include <utility>
 
 #include <boost/utility/string_view.hpp>
 #include <boost/endian/conversion.hpp>
 
+#include "DBFArena.h"
+#include "DBFFixedString.hpp"
+#include "DBFGbkCodec.h"
 #include "StringUtil.hpp"
 
 namespace dbf {
+enum class DBFStatus : uint8_t {
+  kOk,
+  kInsufficientData,
+  kMalformedNumeric,
+  kMalformedDate,
+  kMalformedLogical,
+  kMalformedText,
+  kBadDeleteFlag,
+  kParseException, // ¼ԼparseFrom׳쳣
+  kStatusCount
+};
+
 class DBFBuffer {
 public:
   explicit DBFBuffer(size_t initialSize = 1024, size_t cheapPrepend = 8)
       : buf_(cheapPrepend + initialSize), kCheapPrepend(cheapPrepend),
-        readerIndex_(cheapPrepend), writerIndex_(cheapPrepend) {
+        readerIndex_(cheapPrepend), writerIndex_(cheapPrepend),
+        throwOnError_(true), status_(DBFStatus::kOk), errorReadable_(0) {
     assert(readableBytes() == 0);
     assert(writableBytes() == initialSize);
     assert(prependableBytes() == kCheapPrepend);
   }
 
+  // ڴresource䣬DBFArena::resource()
+  explicit DBFBuffer(pmr::memory_resource *resource, size_t initialSize = 1024,
+                     size_t cheapPrepend = 8)
+      : buf_(cheapPrepend + initialSize,
+             pmr::polymorphic_allocator<char>(resource)),
+        kCheapPrepend(cheapPrepend), readerIndex_(cheapPrepend),
+        writerIndex_(cheapPrepend), throwOnError_(true),
+        status_(DBFStatus::kOk), errorReadable_(0) {
+    assert(readableBytes() == 0);
+    assert(writableBytes() == initialSize);
+    assert(prependableBytes() == kCheapPrepend);
+  }
+
+  pmr::memory_resource *resource() const {
+    return buf_.get_allocator().resource();
+  }
+
+  DBFBuffer(const DBFBuffer &other) = default;
+
+  // ڴ棬ߵĻֻԤԿɼʹ
+  DBFBuffer(DBFBuffer &&other)
+      : buf_(std::move(other.buf_)), kCheapPrepend(other.kCheapPrepend),
+        readerIndex_(other.readerIndex_), writerIndex_(other.writerIndex_),
+        throwOnError_(other.throwOnError_), status_(other.status_),
+        errorReadable_(other.errorReadable_) {
+    other.buf_.resize(kCheapPrepend);
+    other.retrieveAll();
+    other.clearStatus();
+  }
+
   ~DBFBuffer() {}
 
   void retrieveAll() {
@@ -118,16 +166,73 @@ public:
   }
 
   template <size_t FieldLen, typename T> T readInt() {
-    auto view = readStringView<FieldLen>();
-    if (view.empty()) {
+    return readInt<FieldLen, 0, T>();
+  }
+
+  template <size_t FieldLen, size_t PrecisionSize, typename T> T readInt() {
+    if (!checkReadable(FieldLen)) {
+      return T(0);
+    }
+    T value(0);
+    if (!util::decimalToInt(peek(), FieldLen, PrecisionSize, value)) {
+      fail(DBFStatus::kMalformedNumeric, "Malformed numeric field", peek(),
+           FieldLen);
+      return T(0);
+    }
+    retrieve(FieldLen);
+    return value;
+  }
+
+  template <size_t FieldLen, size_t PrecisionSize> double readDouble() {
+    if (!checkReadable(FieldLen)) {
       return 0;
     }
-    return stringViewToInt<T>(view);
+    double value = 0;
+    if (!util::decimalToDouble(peek(), FieldLen, PrecisionSize, value)) {
+      fail(DBFStatus::kMalformedNumeric, "Malformed numeric field", peek(),
+           FieldLen);
+      return 0;
+    }
+    retrieve(FieldLen);
+    return value;
   }
 
-  template <size_t FieldLen, size_t PrecisionSize, typename T> T readInt() {
-    auto view = readStringView<FieldLen>();
-    return floatStringViewToInt<FieldLen, PrecisionSize, T>(view);
+  template <size_t FieldLen> int32_t readDate() {
+    if (!checkReadable(FieldLen)) {
+      return util::kNullDate;
+    }
+    int32_t days = util::kNullDate;
+    if (!util::dateToDays(peek(), FieldLen, days)) {
+      fail(DBFStatus::kMalformedDate, "Malformed date field", peek(),
+           FieldLen);
+      return util::kNullDate;
+    }
+    retrieve(FieldLen);
+    return days;
+  }
+
+  template <size_t FieldLen> util::Logical readLogical() {
+    if (!checkReadable(FieldLen)) {
+      return util::Logical::kUnknown;
+    }
+    util::Logical value = util::Logical::kUnknown;
+    if (FieldLen != 1 || !util::charToLogical(*peek(), value)) {
+      fail(DBFStatus::kMalformedLogical, "Malformed logical field", peek(),
+           FieldLen);
+      return util::Logical::kUnknown;
+    }
+    retrieve(FieldLen);
+    return value;
+  }
+
+  template <size_t FieldLen> bool readBool() {
+    return readLogical<FieldLen>() == util::Logical::kTrue;
+  }
+
+  // MֶεĿţdBase IIIΪ10λʮƣVisual FoxProΪ4ֽС
+  template <size_t FieldLen> uint32_t readMemoBlock() {
+    return FieldLen == sizeof(uint32_t) ? readBinaryUint32()
+                                        : readInt<FieldLen, uint32_t>();
   }
 
   template <size_t FieldLen> inline std::string readString() {
@@ -136,10 +241,8 @@ public:
   }
 
   template <size_t FieldLen> inline boost::string_view readStringView() {
-    if (readableBytes() < FieldLen) {
-      std::stringstream ss;
-      ss << "Insufficient readable data";
-      throw std::range_error(ss.str().c_str());
+    if (!checkReadable(FieldLen)) {
+      return boost::string_view();
     }
     boost::string_view view(peek(), FieldLen);
     trim(view);
@@ -147,11 +250,36 @@ public:
     return view;
   }
 
+  /**
+   * @brief  GBKֶַβתUTF-8ASCIIʱֱӷָ򻺳ͼ
+   *         ת÷ṩdstȡDBFGbkCodec::maxUtf8Bytes(FieldLen)
+   *         ɣصͼ´ζдdstʧЧǰЧ
+   */
+  template <size_t FieldLen>
+  inline boost::string_view readUtf8StringView(char *dst, size_t cap) {
+    auto view = readStringView<FieldLen>();
+    if (util::isAscii(view.data(), view.size())) {
+      return view;
+    }
+    size_t len =
+        DBFGbkCodec::instance().toUtf8(view.data(), view.size(), dst, cap);
+    if (len == DBFGbkCodec::npos) {
+      fail(DBFStatus::kMalformedText, "Malformed gbk field", view.data(),
+           view.size());
+      return boost::string_view();
+    }
+    return boost::string_view(dst, len);
+  }
+
+  template <size_t FieldLen> inline std::string readUtf8String() {
+    std::array<char, DBFGbkCodec::maxUtf8Bytes(FieldLen)> arr;
+    auto view = readUtf8StringView<FieldLen>(arr.data(), arr.size());
+    return std::string(view.data(), view.size());
+  }
+
   inline char readChar() {
-    if (readableBytes() < sizeof(char)) {
-      std::stringstream ss;
-      ss << "Insufficient readable data";
-      throw std::range_error(ss.str().c_str());
+    if (!checkReadable(sizeof(char))) {
+      return 0;
     }
     char ch = *peek();
     retrieve(sizeof(char));
@@ -162,10 +290,26 @@ public:
     std::array<char, FieldLen> arr;
     arr.fill(' ');
     auto view = readStringView<FieldLen>();
-    std::memcpy(arr.data(), view.data(), FieldLen);
+    if (!view.empty()) {
+      std::memcpy(arr.data(), view.data(), view.size());
+    }
     return arr;
   }
 
+  // ȥβոַڴ
+  template <size_t FieldLen, size_t Capacity = FieldLen>
+  inline FixedString<Capacity> readFixedString() {
+    FixedString<Capacity> str;
+    auto view = readStringView<FieldLen>();
+    if (view.size() > Capacity) {
+      fail(DBFStatus::kMalformedText, "Fixed string value too long",
+           view.data(), view.size());
+      return str;
+    }
+    str.assign(view.data(), view.size());
+    return str;
+  }
+
   template <size_t FieldLen> void appendInt8(int8_t val) {
     appendInt16<FieldLen>(static_cast<int16_t>(val));
   }
@@ -239,18 +383,60 @@ public:
   }
 
   template <size_t FieldLen, typename T> inline void appendInt(T val) {
-    ensureWritableBytes(FieldLen);
-    boost::string_view view(beginWrite(), FieldLen);
-    intToStringView<T>(val, view);
-    append<FieldLen>(view);
+    appendInt<FieldLen, 0, T>(val);
   }
 
   template <size_t FieldLen, size_t PrecisionSize, typename T>
   inline void appendInt(T val) {
     ensureWritableBytes(FieldLen);
-    boost::string_view view(beginWrite(), FieldLen);
-    intToFloatStringView<FieldLen, PrecisionSize, T>(val, view);
-    append<FieldLen>(view);
+    if (!util::formatDecimal(beginWrite(), FieldLen, PrecisionSize, val)) {
+      std::stringstream ss;
+      ss << "Append value too long : " << +val;
+      throw std::range_error(ss.str().c_str());
+    }
+    hasWritten(FieldLen);
+  }
+
+  template <size_t FieldLen, size_t PrecisionSize>
+  inline void appendDouble(double val) {
+    ensureWritableBytes(FieldLen);
+    if (!util::formatDouble(beginWrite(), FieldLen, PrecisionSize, val)) {
+      std::stringstream ss;
+      ss << "Append value too long : " << val;
+      throw std::range_error(ss.str().c_str());
+    }
+    hasWritten(FieldLen);
+  }
+
+  template <size_t FieldLen> inline void appendDate(int32_t days) {
+    ensureWritableBytes(FieldLen);
+    if (!util::formatDate(beginWrite(), FieldLen, days)) {
+      std::stringstream ss;
+      ss << "Append date out of range : " << days;
+      throw std::range_error(ss.str().c_str());
+    }
+    hasWritten(FieldLen);
+  }
+
+  template <size_t FieldLen> inline void appendLogical(util::Logical val) {
+    static_assert(FieldLen == 1, "logical field length must be 1");
+    appendChar(util::logicalToChar(val));
+  }
+
+  template <size_t FieldLen> inline void appendBool(bool val) {
+    appendLogical<FieldLen>(val ? util::Logical::kTrue : util::Logical::kFalse);
+  }
+
+  template <size_t FieldLen> inline void appendMemoBlock(uint32_t block) {
+    if (FieldLen == sizeof(uint32_t)) {
+      appendBinaryUint32(block);
+    } else if (block == 0) {
+      ensureWritableBytes(FieldLen);
+      std::memset(beginWrite(), ' ', FieldLen);
+      hasWritten(FieldLen);
+    } else {
+      appendInt<FieldLen>(block);
+    }
   }
 
   template <size_t FieldLen> inline void appendString(const std::string &val) {
@@ -267,6 +453,32 @@ public:
     hasWritten(FieldLen);
   }
 
+  template <size_t FieldLen, size_t Capacity>
+  inline void appendString(const FixedString<Capacity> &val) {
+    static_assert(Capacity <= FieldLen, "Fixed string capacity exceeds field");
+    ensureWritableBytes(FieldLen);
+    std::memcpy(beginWrite(), val.data(), val.size());
+    std::memset(beginWrite() + val.size(), ' ', FieldLen - val.size());
+    hasWritten(FieldLen);
+  }
+
+  // UTF-8ַתGBKֱдֶΣҲಹո
+  template <size_t FieldLen>
+  inline void appendUtf8String(const boost::string_view &val) {
+    ensureWritableBytes(FieldLen);
+    size_t len = DBFGbkCodec::instance().toGbk(val.data(), val.size(),
+                                               beginWrite(), FieldLen);
+    if (len == DBFGbkCodec::npos) {
+      std::stringstream ss;
+      ss << "Append value too long or not gbk : " << val;
+      throw std::range_error(ss.str().c_str());
+    }
+    if (FieldLen > len) {
+      std::memset(beginWrite() + len, ' ', FieldLen - len);
+    }
+    hasWritten(FieldLen);
+  }
+
   inline void appendChar(char val) {
     ensureWritableBytes(sizeof val);
     *beginWrite() = val;
@@ -297,10 +509,8 @@ public:
   uint64_t readBinaryUint64() { return readBinaryInt<uint64_t>(); }
 
   template <typename T> T readBinaryInt() {
-    if (readableBytes() < sizeof(T)) {
-      std::stringstream ss;
-      ss << "Insufficient readable data";
-      throw std::range_error(ss.str().c_str());
+    if (!checkReadable(sizeof(T))) {
+      return T(0);
     }
     T val;
     std::memcpy(&val, peek(), sizeof val);
@@ -308,11 +518,29 @@ public:
     return boost::endian::little_to_native(val);
   }
 
+  double readBinaryDouble() {
+    uint64_t bits = readBinaryUint64();
+    double val = 0;
+    std::memcpy(&val, &bits, sizeof val);
+    return val;
+  }
+
+  // YֶΣŴ10^4int64
+  int64_t readBinaryCurrency() { return readBinaryInt64(); }
+
+  // TֶΣ1970-01-01ĺֵΪutil::kNullDateTime
+  int64_t readBinaryDateTime() {
+    if (!checkReadable(2 * sizeof(int32_t))) {
+      return util::kNullDateTime;
+    }
+    int32_t day = readBinaryInt32();
+    int32_t millis = readBinaryInt32();
+    return util::julianToMillis(day, millis);
+  }
+
   template <size_t FieldLen> inline std::string readBinaryString() {
-    if (readableBytes() < FieldLen) {
-      std::stringstream ss;
-      ss << "Insufficient readable data";
-      throw std::range_error(ss.str().c_str());
+    if (!checkReadable(FieldLen)) {
+      return std::string();
     }
     auto len = FieldLen;
     while (len > 0 && peek()[len - 1] == 0) {
@@ -342,6 +570,23 @@ public:
 
   void appendBinaryUint64(uint64_t val) { appendBinaryInt(val); }
 
+  void appendBinaryDouble(double val) {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &val, sizeof bits);
+    appendBinaryInt(bits);
+  }
+
+  void appendBinaryCurrency(int64_t val) { appendBinaryInt(val); }
+
+  void appendBinaryDateTime(int64_t millis) {
+    int32_t day = 0;
+    int32_t time = 0;
+    util::millisToJulian(millis, day, time);
+    ensureWritableBytes(2 * sizeof(int32_t));
+    appendBinaryInt(day);
+    appendBinaryInt(time);
+  }
+
   template <typename T> inline void appendBinaryInt(T val) {
     ensureWritableBytes(sizeof val);
     val = boost::endian::native_to_little(val);
@@ -364,6 +609,40 @@ public:
     hasWritten(FieldLen);
   }
 
+  /**
+   * @brief  throwOnErrorΪfalseʱʧܲ쳣µһ״̬
+   *         Ĭֵ֮ĶȡֱӷĬֵɵ÷status()
+   *         clearStatus()ֻ༸η֧ж
+   */
+  void setThrowOnError(bool val) { throwOnError_ = val; }
+  bool throwOnError() const { return throwOnError_; }
+  DBFStatus status() const { return status_; }
+  size_t errorReadable() const { return errorReadable_; }
+  void clearStatus() {
+    status_ = DBFStatus::kOk;
+    errorReadable_ = 0;
+  }
+
+  bool fail(DBFStatus status, const char *what, const char *data = nullptr,
+            size_t len = 0) {
+    if (throwOnError_) {
+      std::stringstream ss;
+      ss << what;
+      if (data != nullptr) {
+        ss << " : " << std::string(data, len);
+      }
+      if (status == DBFStatus::kInsufficientData) {
+        throw std::range_error(ss.str().c_str());
+      }
+      throw std::invalid_argument(ss.str().c_str());
+    }
+    if (status_ == DBFStatus::kOk) {
+      status_ = status;
+      errorReadable_ = readableBytes();
+    }
+    return false;
+  }
+
   void ensureWritableBytes(size_t len) {
     if (writableBytes() < len) {
       makeSpace(len);
@@ -385,25 +664,47 @@ public:
     writerIndex_ -= len;
   }
 
+  /**
+   * @brief  serializeдһһ¼쳣ʱ˱дȫֽ׳
+   *         е¼Ӱ죬дһļ¼
+   */
+  template <typename Serialize> void serializeOrRollback(Serialize serialize) {
+    size_t mark = readableBytes();
+    try {
+      serialize();
+    } catch (...) {
+      unwrite(readableBytes() - mark);
+      throw;
+    }
+  }
+
 private:
+  bool checkReadable(size_t len) {
+    if (status_ != DBFStatus::kOk) {
+      return false;
+    }
+    return readableBytes() >= len ||
+           fail(DBFStatus::kInsufficientData, "Insufficient readable data");
+  }
+
   char *begin() { return &*buf_.begin(); }
 
   const char *begin() const { return &*buf_.begin(); }
 
   void makeSpace(size_t len) {
-    if (writableBytes() + prependableBytes() < len + kCheapPrepend) {
-      // FIXME: move readable data
-      buf_.resize(writerIndex_ + len);
-    } else {
-      // move readable data to the front, make space inside buffer
-      assert(kCheapPrepend < readerIndex_);
-      size_t readable = readableBytes();
-      std::memcpy(begin() + kCheapPrepend, begin() + readerIndex_,
-                  writerIndex_ - readerIndex_);
+    // move readable data to the front, then grow if still not enough
+    size_t readable = readableBytes();
+    if (readerIndex_ > kCheapPrepend) {
+      std::memmove(begin() + kCheapPrepend, begin() + readerIndex_, readable);
       readerIndex_ = kCheapPrepend;
       writerIndex_ = readerIndex_ + readable;
-      assert(readable == readableBytes());
     }
+    if (writableBytes() < len) {
+      // ٷ׷ʱÿζ·䣻ֲҪ
+      buf_.resize(std::max(writerIndex_ + len, buf_.size() * 2),
+                  boost::container::default_init);
+    }
+    assert(readable == readableBytes());
   }
 
   template <size_t FieldLen>
@@ -428,10 +729,13 @@ private:
   }
 
 private:
-  std::vector<char> buf_;
+  pmr::vector<char> buf_;
   const size_t kCheapPrepend;
   size_t readerIndex_;
   size_t writerIndex_;
+  bool throwOnError_;
+  DBFStatus status_;
+  size_t errorReadable_;
 };
 } // namespace dbf
 
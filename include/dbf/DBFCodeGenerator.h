@@ -0,0 +1,63 @@
+#ifndef DBF_CODE_GENERATOR_H
+#define DBF_CODE_GENERATOR_H
+
+#include <string>
+#include <vector>
+
+#include "DBFHeadField.h"
+
+namespace dbf {
+class DBFFile;
+
+/**
+ * @brief  dbfļͷɼ¼ࣺ<Class>.h/<Class>.cppΪ¼
+ *         DBFBufferparseFrom/serializeTo̶ƫƵdecode/encode
+ *         ͷdecodeBatch<Class>JsonSerializer.hpp<Class>Formatter.h
+ *         ṩnlohmann::jsonfmt֧֣DBFHeadɴһ
+ */
+class DBFCodeGenerator {
+public:
+  struct Member {
+    std::string fieldName;
+    std::string memberName;
+    std::string accessorName;
+    std::string type;
+    char fieldType;
+    size_t offset;
+    size_t totalLen;
+    size_t precisionLen;
+  };
+
+public:
+  explicit DBFCodeGenerator(const std::string &className,
+                            const std::string &nameSpace = "dbf");
+
+public:
+  bool load(const DBFFile &file);
+  bool load(const std::vector<DBFHeadField> &fields);
+
+  const std::vector<Member> &members() const { return members_; }
+  size_t recordBytes() const { return recordBytes_; }
+
+  std::string header() const;
+  std::string source() const;
+  std::string jsonSerializer() const;
+  std::string formatter() const;
+
+  bool writeFiles(const std::string &dir) const;
+
+private:
+  std::string guard(const std::string &suffix) const;
+  std::string readCall(const Member &member) const;
+  std::string appendCall(const Member &member) const;
+  std::string valueExpr(const Member &member, const std::string &obj) const;
+
+private:
+  std::string className_;
+  std::string nameSpace_;
+  std::vector<Member> members_;
+  size_t recordBytes_;
+};
+} // namespace dbf
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef DBF_DIAGNOSTICS_H
+#define DBF_DIAGNOSTICS_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "DBFBuffer.hpp"
+
+namespace dbf {
+class DBFDiagnostics {
+public:
+  struct Sample {
+    DBFStatus status;
+    size_t readPos;
+    size_t offset;
+  };
+
+public:
+  DBFDiagnostics() : total_(0) { counts_.fill(0); }
+
+public:
+  /**
+   * @brief  ¼һνʧܣ״ֻ̬ǰkMaxSamples
+   *
+   * @param readPos ¼ļеλ
+   * @param offset ֶڼ¼еƫ
+   */
+  void record(DBFStatus status, size_t readPos, size_t offset) {
+    ++counts_[static_cast<size_t>(status)];
+    ++total_;
+    if (samples_.size() < kMaxSamples) {
+      samples_.push_back(Sample{status, readPos, offset});
+    }
+  }
+
+  void clear() {
+    counts_.fill(0);
+    total_ = 0;
+    samples_.clear();
+  }
+
+  size_t count(DBFStatus status) const {
+    return counts_[static_cast<size_t>(status)];
+  }
+  size_t total() const { return total_; }
+  const std::vector<Sample> &samples() const { return samples_; }
+
+private:
+  std::array<size_t, static_cast<size_t>(DBFStatus::kStatusCount)> counts_;
+  size_t total_;
+  std::vector<Sample> samples_;
+
+private:
+  static const size_t kMaxSamples = 16;
+};
+} // namespace dbf
+
+#endif // !DBF_DIAGNOSTICS_H
@@ -0,0 +1,75 @@
+#ifndef DBF_DIRECT_WRITER_H
+#define DBF_DIRECT_WRITER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <list>
+#include <memory>
+
+namespace dbf {
+class DBFBuffer;
+class DBFFile;
+class DBFRecord;
+
+class DBFDirectWriter {
+public:
+  explicit DBFDirectWriter(DBFFile &file, size_t blockBytes = kBlockBytes);
+  ~DBFDirectWriter();
+
+  DBFDirectWriter(const DBFDirectWriter &) = delete;
+  DBFDirectWriter &operator=(const DBFDirectWriter &) = delete;
+
+public:
+  bool open();
+  bool commit();
+
+  bool appendWriten(const DBFRecord &record);
+  bool appendWriten(const std::shared_ptr<DBFRecord> &record);
+  bool appendWriten(const std::list<std::shared_ptr<DBFRecord>> &records);
+
+  bool isOpen() const;
+  bool direct() const { return direct_; }
+
+private:
+  bool append(const char *data, size_t len);
+  bool flushBlock(size_t len);
+  bool waitPending();
+  bool patchRecordNumber();
+
+  bool openFile();
+  bool closeFile();
+  bool writeAt(const char *buf, size_t len, size_t pos);
+  bool readAt(char *buf, size_t len, size_t pos);
+  bool truncate(size_t len);
+
+  static size_t alignUp(size_t len) {
+    return std::max<size_t>((len + kAlignBytes - 1) / kAlignBytes, 1) *
+           kAlignBytes;
+  }
+
+private:
+  DBFFile &file_;
+  size_t blockBytes_;
+  char *blocks_[2];
+  size_t current_;
+  size_t used_;
+  size_t blockPos_;
+  size_t records_;
+  std::future<bool> pending_;
+  std::unique_ptr<DBFBuffer> buf_;
+  bool direct_;
+  bool failed_;
+#ifdef _WIN32
+  void *handle_;
+#else
+  int fd_;
+#endif
+
+private:
+  static const size_t kAlignBytes = 4096;
+  static const size_t kBlockBytes = 1024 * 1024;
+};
+} // namespace dbf
+
+#endif // !DBF_DIRECT_WRITER_H
@@ -0,0 +1,108 @@
+#ifndef DBF_DYNAMIC_RECORD_H
+#define DBF_DYNAMIC_RECORD_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <boost/utility/string_view.hpp>
+
+#include "DBFArena.h"
+#include "DBFRecord.h"
+#include "DBFRecordView.h"
+#include "DBFTable.h"
+
+namespace dbf {
+/**
+ * @brief  ṹʵͨü¼parseFromֻ¼ԭʼֽڣ
+ *         ֶڱʱŽ룬ûɼ¼ĳ
+ *         ַʲڵֶ׳out_of_rangeʽͬDBFRecordView
+ */
+class DBFDynamicRecord : public DBFRecord {
+public:
+  // allocator_type󣬷ŽpmrRecordBatchʱresource
+  typedef pmr::polymorphic_allocator<char> allocator_type;
+
+public:
+  explicit DBFDynamicRecord(const DBFTable &table,
+                            const allocator_type &alloc = allocator_type());
+  DBFDynamicRecord(const DBFDynamicRecord &other, const allocator_type &alloc);
+  DBFDynamicRecord(const DBFDynamicRecord &other) = default;
+  DBFDynamicRecord &operator=(const DBFDynamicRecord &other) = default;
+
+public:
+  virtual void parseFrom(DBFBuffer &buf) override;
+  virtual void serializeTo(DBFBuffer &buf) const override;
+  virtual std::string toString() const override;
+
+public:
+  const DBFTable &table() const { return *table_; }
+  allocator_type get_allocator() const { return bytes_.get_allocator(); }
+  DBFRecordView view() const {
+    return DBFRecordView(bytes_.data(), &table_->layout(), readPos());
+  }
+
+  // һԭʼ¼Ϊtable().recordBytes()
+  void assign(const char *data);
+  void assign(const DBFRecordView &view) { assign(view.data()); }
+
+  size_t indexOf(const boost::string_view &name) const {
+    size_t index = table_->indexOf(name);
+    if (index == DBFTable::npos) {
+      throw std::out_of_range("Unknown field : " + name.to_string());
+    }
+    return index;
+  }
+
+  boost::string_view stringView(size_t index) const {
+    return view().stringView(index);
+  }
+  boost::string_view stringView(const boost::string_view &name) const {
+    return view().stringView(indexOf(name));
+  }
+
+  std::string readString(size_t index) const {
+    return view().readString(index);
+  }
+  std::string readString(const boost::string_view &name) const {
+    return view().readString(indexOf(name));
+  }
+
+  boost::string_view readUtf8StringView(size_t index, char *dst,
+                                        size_t cap) const {
+    return view().readUtf8StringView(index, dst, cap);
+  }
+  boost::string_view readUtf8StringView(const boost::string_view &name,
+                                        char *dst, size_t cap) const {
+    return view().readUtf8StringView(indexOf(name), dst, cap);
+  }
+
+  int64_t readInt64(size_t index) const;
+  int64_t readInt64(const boost::string_view &name) const {
+    return readInt64(indexOf(name));
+  }
+
+  double readDouble(size_t index) const;
+  double readDouble(const boost::string_view &name) const {
+    return readDouble(indexOf(name));
+  }
+
+  int32_t readDate(size_t index) const { return view().readDate(index); }
+  int32_t readDate(const boost::string_view &name) const {
+    return view().readDate(indexOf(name));
+  }
+
+  util::Logical readLogical(size_t index) const {
+    return view().readLogical(index);
+  }
+  util::Logical readLogical(const boost::string_view &name) const {
+    return view().readLogical(indexOf(name));
+  }
+
+private:
+  const DBFTable *table_;
+  pmr::vector<char> bytes_;
+};
+} // namespace dbf
+
+#endif
@@ -3,27 +3,40 @@
 
 #include <cstdio>
 #include <ctime>
+#include <exception>
 #include <fstream>
 #include <list>
 #include <string>
 #include <vector>
 
+#include "DBFDiagnostics.h"
 #include "DBFHeadField.h"
+#include "DBFRecordBatch.hpp"
+#include "DBFRecordView.h"
+#include "DBFScanner.h"
 
 namespace dbf {
-class DBFRecord;
-class DBFBuffer;
 class DBFHead;
+class DBFLiveBitmap;
+class DBFStorage;
 
 class DBFFile {
+public:
+  enum SyncPolicy { kSyncNone, kSyncBatch, kSyncClose };
+  enum Format { kDbase3 = 0x03, kVisualFoxPro = 0x30 };
+  enum DecodeMode { kDecodeThrow, kDecodeStatus };
+
 public:
   explicit DBFFile(const std::string &name);
+  explicit DBFFile(std::unique_ptr<DBFStorage> storage);
   virtual ~DBFFile();
 
 public:
   void appendHeadField(const std::string &name, const std::string &type,
                        uint8_t totalLen = 0, uint8_t precisionLen = 0);
   const std::vector<DBFHeadField> &headFields() const { return headFields_; }
+  void setFormat(Format format) { format_ = format; }
+  Format format() const { return format_; }
 
   bool readRecordNumber();
   bool writeRecordNumber();
@@ -36,6 +49,8 @@ public:
   bool overRead(DBFRecord &record);
   bool overRead(const std::shared_ptr<DBFRecord> &record);
   bool overRead(const std::list<std::shared_ptr<DBFRecord>> &records);
+  bool read(DBFRecordView &view);
+  bool overRead(DBFRecordView &view);
 
   bool overWriten(const DBFRecord &record);
   bool overWriten(const std::shared_ptr<DBFRecord> &record);
@@ -44,7 +59,13 @@ public:
   bool appendWriten(const std::shared_ptr<DBFRecord> &record);
   bool appendWriten(const std::list<std::shared_ptr<DBFRecord>> &records);
 
+  template <typename T> bool read(RecordBatch<T> &records);
+  template <typename T> bool overRead(RecordBatch<T> &records);
+  template <typename T> bool overWriten(RecordBatch<T> &records);
+  template <typename T> bool appendWriten(const RecordBatch<T> &records);
+
   const std::unique_ptr<DBFHead> &head() const { return head_; }
+  const DBFRecordLayout &layout() const { return layout_; }
   size_t writerPos() const { return writerPos_; }
   void setWriterPos(size_t val) { writerPos_ = val; }
   size_t readerPos() const { return readerPos_; }
@@ -54,6 +75,29 @@ public:
   bool read(char *buf, long start, size_t len);
   const std::string &name() const { return name_; }
 
+  bool openSession(bool readOnly = false);
+  bool closeSession();
+  bool inSession() const { return storage_ != nullptr; }
+
+  bool openMap();
+  bool openWritableMap(SyncPolicy policy = kSyncNone);
+  bool closeMap();
+  bool isMapped() const;
+  bool sync();
+
+  DBFScanner scan(size_t chunkBytes = kScanChunkBytes);
+  bool scanLive(DBFLiveBitmap &bitmap, size_t chunkBytes = kScanChunkBytes);
+
+  void setDecodeMode(DecodeMode mode) { decodeMode_ = mode; }
+  DecodeMode decodeMode() const { return decodeMode_; }
+  const DBFDiagnostics &diagnostics() const { return diagnostics_; }
+  void clearDiagnostics() { diagnostics_.clear(); }
+
+  bool beginBulkLoad(size_t expectedRecords = 0,
+                     size_t bufferBytes = kBulkBufferBytes);
+  bool commitBulkLoad();
+  bool inBulkLoad() const { return bulkBuf_ != nullptr; }
+
 private:
   bool open(const std::string &mode);
   bool close();
@@ -69,6 +113,23 @@ private:
   bool read(DBFBuffer &buf);
   bool appendWriten(const DBFBuffer &buf);
   bool appendRecordWriten(const DBFBuffer &buf);
+  bool viewAt(DBFRecordView &view, size_t pos);
+  bool parseRecord(DBFRecord &record, DBFBuffer &buf, size_t pos);
+  template <typename T> bool decodeRecord(T &record, size_t pos);
+  template <typename Parse>
+  bool decodeStatus(DBFBuffer &buf, size_t pos, Parse parse);
+  bool fillRecords(size_t pos, size_t count);
+  bool parseFailed(const std::exception &ex);
+  bool skipRecord(DBFBuffer &buf, size_t pos, size_t before);
+  bool checkRecordWritable() const;
+  DBFBuffer &beginAppend();
+  bool commitAppend(size_t count);
+  bool overWritenBatch();
+  size_t recordBytes() const;
+  void serializeHead(DBFBuffer &buf);
+  bool closeStorage();
+  bool syncBatch();
+  bool flushBulk();
 
 private:
   void checkHeadField(const DBFHeadField &, const DBFHeadField &);
@@ -77,12 +138,27 @@ private:
   std::string name_;
   FILE *file_;
   std::vector<DBFHeadField> headFields_;
+  std::vector<const DBFRecord *> scatter_;
+  std::vector<DBFRecord *> batch_;
 
   size_t writerPos_;
   size_t readerPos_;
 
   std::unique_ptr<DBFHead> head_;
   std::unique_ptr<DBFBuffer> buf_;
+  std::unique_ptr<DBFStorage> storage_;
+  bool attached_;
+  SyncPolicy syncPolicy_;
+  Format format_;
+  DecodeMode decodeMode_;
+  DBFDiagnostics diagnostics_;
+  DBFRecordLayout layout_;
+
+  std::unique_ptr<DBFBuffer> bulkBuf_;
+  size_t bulkBytes_;
+  size_t bulkPos_;
+  bool bulkSession_;
+  bool bulkFailed_;
 
 private:
   static const long kRecorNumIndex = 4;
@@ -90,7 +166,123 @@ private:
   static const size_t kFieldLen = 32;
   static const char kEndHeadFlag = 0x0D;
   static const char kEndFileFlag = 0x1A;
+  static const size_t kBacklinkBytes = 263;
+  static const int8_t kDbtVersion = static_cast<int8_t>(0x83);
+  static const int8_t kFptFlag = 0x02;
+  static const size_t kScanChunkBytes = 1024 * 1024;
+  static const size_t kBulkBufferBytes = 4 * 1024 * 1024;
+
+  friend class DBFScanner;
+  friend class DBFIoBatch;
+  friend class DBFDirectWriter;
 };
+
+template <typename T> bool DBFFile::read(RecordBatch<T> &records) {
+  if (!fillRecords(readerPos_, records.size())) {
+    return false;
+  }
+
+  auto pos = readerPos_;
+  for (auto &record : records) {
+    record.setReadPos(pos);
+    if (!decodeRecord(record, pos)) {
+      return false;
+    }
+    pos += recordBytes();
+  }
+  readerPos_ = pos;
+  return true;
+}
+
+template <typename T> bool DBFFile::overRead(RecordBatch<T> &records) {
+  if (records.empty()) {
+    return true;
+  }
+
+  auto pos = records.front().readPos();
+  if (0 == pos) {
+    pos = readerPos_;
+  }
+  if (!fillRecords(pos, records.size())) {
+    return false;
+  }
+
+  for (auto &record : records) {
+    if (!decodeRecord(record, pos)) {
+      return false;
+    }
+    record.setReadPos(pos);
+    pos += recordBytes();
+  }
+
+  if (readerPos_ < pos) {
+    readerPos_ = pos;
+  }
+  return true;
+}
+
+template <typename T> bool DBFFile::overWriten(RecordBatch<T> &records) {
+  if (!checkRecordWritable()) {
+    return false;
+  }
+  batch_.clear();
+  for (auto &record : records) {
+    batch_.push_back(&record);
+  }
+  return overWritenBatch();
+}
+
+template <typename T>
+bool DBFFile::appendWriten(const RecordBatch<T> &records) {
+  if (!checkRecordWritable()) {
+    return false;
+  }
+  auto &buf = beginAppend();
+  buf.serializeOrRollback([&records, &buf] {
+    for (auto &record : records) {
+      record.T::serializeTo(buf);
+    }
+  });
+  return commitAppend(records.size());
+}
+
+/**
+ * @brief  parseRecordͬ¼ڱֱ֪ӵT::parseFrom
+ */
+template <typename T> bool DBFFile::decodeRecord(T &record, size_t pos) {
+  if (decodeMode_ == kDecodeThrow) {
+    try {
+      record.T::parseFrom(*buf_);
+    } catch (const std::exception &ex) {
+      return parseFailed(ex);
+    }
+    return true;
+  }
+
+  return decodeStatus(*buf_, pos,
+                      [this, &record] { record.T::parseFrom(*buf_); });
+}
+
+/**
+ * @brief  kDecodeStatus½һ¼buf쳣ʽֻ״̬
+ *         parseFromԼ׳쳣ҲΪkParseExceptionӳӿڡ
+ *         ˳ָbuf쳣ģʽ
+ */
+template <typename Parse>
+bool DBFFile::decodeStatus(DBFBuffer &buf, size_t pos, Parse parse) {
+  buf.setThrowOnError(false);
+  size_t before = buf.readableBytes();
+  try {
+    parse();
+  } catch (const std::exception &ex) {
+    buf.fail(DBFStatus::kParseException, ex.what());
+  } catch (...) {
+    buf.setThrowOnError(true);
+    throw;
+  }
+  buf.setThrowOnError(true);
+  return buf.status() == DBFStatus::kOk || skipRecord(buf, pos, before);
+}
 } // namespace dbf
 
 #endif // !DBF_FILE_H
@@ -0,0 +1,145 @@
+#ifndef DBF_FIXED_STRING_HPP
+#define DBF_FIXED_STRING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/functional/hash.hpp>
+#include <boost/utility/string_view.hpp>
+
+namespace dbf {
+/**
+ * @brief  ַCֶΣݴڶڲȵһֽڼ¼
+ *         дڴ档ȥβոݣļһ
+ */
+template <size_t Capacity> class FixedString {
+  static_assert(Capacity > 0 && Capacity <= UINT8_MAX,
+                "FixedString capacity must be in [1, 255]");
+
+public:
+  static constexpr size_t kCapacity = Capacity;
+
+public:
+  FixedString() : size_(0) {}
+  FixedString(const char *str) { assign(str, std::strlen(str)); }
+  FixedString(const char *data, size_t len) { assign(data, len); }
+  FixedString(const std::string &str) { assign(str.data(), str.size()); }
+  FixedString(const boost::string_view &view) {
+    assign(view.data(), view.size());
+  }
+
+  // ʱ׳range_errorDBFBuffer::appendStringһ
+  void assign(const char *data, size_t len) {
+    if (len > Capacity) {
+      throw std::range_error("Fixed string value too long : " +
+                             std::string(data, len));
+    }
+    if (len > 0) {
+      std::memcpy(data_, data, len);
+    }
+    size_ = static_cast<uint8_t>(len);
+  }
+
+  void clear() { size_ = 0; }
+
+  const char *data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  static constexpr size_t capacity() { return Capacity; }
+
+  const char *begin() const { return data_; }
+  const char *end() const { return data_ + size_; }
+  char operator[](size_t pos) const { return data_[pos]; }
+
+  boost::string_view view() const { return boost::string_view(data_, size_); }
+  std::string str() const { return std::string(data_, size_); }
+  operator boost::string_view() const { return view(); }
+
+  int compare(const boost::string_view &other) const {
+    return view().compare(other);
+  }
+
+private:
+  uint8_t size_;
+  char data_[Capacity];
+};
+
+template <size_t L, size_t R>
+inline bool operator==(const FixedString<L> &lhs, const FixedString<R> &rhs) {
+  return lhs.size() == rhs.size() &&
+         std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+template <size_t L, size_t R>
+inline bool operator!=(const FixedString<L> &lhs, const FixedString<R> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <size_t L, size_t R>
+inline bool operator<(const FixedString<L> &lhs, const FixedString<R> &rhs) {
+  return lhs.compare(rhs.view()) < 0;
+}
+
+template <size_t L, size_t R>
+inline bool operator>(const FixedString<L> &lhs, const FixedString<R> &rhs) {
+  return rhs < lhs;
+}
+
+template <size_t L, size_t R>
+inline bool operator<=(const FixedString<L> &lhs, const FixedString<R> &rhs) {
+  return !(rhs < lhs);
+}
+
+template <size_t L, size_t R>
+inline bool operator>=(const FixedString<L> &lhs, const FixedString<R> &rhs) {
+  return !(lhs < rhs);
+}
+
+template <size_t N>
+inline bool operator==(const FixedString<N> &lhs,
+                       const boost::string_view &rhs) {
+  return lhs.view() == rhs;
+}
+
+template <size_t N>
+inline bool operator==(const boost::string_view &lhs,
+                       const FixedString<N> &rhs) {
+  return rhs.view() == lhs;
+}
+
+template <size_t N>
+inline bool operator!=(const FixedString<N> &lhs,
+                       const boost::string_view &rhs) {
+  return !(lhs == rhs);
+}
+
+template <size_t N>
+inline bool operator!=(const boost::string_view &lhs,
+                       const FixedString<N> &rhs) {
+  return !(rhs == lhs);
+}
+
+template <size_t N>
+inline std::ostream &operator<<(std::ostream &os, const FixedString<N> &str) {
+  return os.write(str.data(), str.size());
+}
+
+template <size_t N> inline size_t hash_value(const FixedString<N> &str) {
+  return boost::hash_range(str.begin(), str.end());
+}
+} // namespace dbf
+
+namespace std {
+template <size_t N> struct hash<dbf::FixedString<N>> {
+  size_t operator()(const dbf::FixedString<N> &str) const {
+    return dbf::hash_value(str);
+  }
+};
+} // namespace std
+
+#endif
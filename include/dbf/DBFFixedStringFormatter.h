@@ -0,0 +1,25 @@
+#ifndef DBF_D_B_F_FIXED_STRING_FORMATTER_H
+#define DBF_D_B_F_FIXED_STRING_FORMATTER_H
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include "dbf/DBFFixedString.hpp"
+
+namespace fmt {
+// FixedStringbegin/endٰrangeʽ
+template <size_t N, typename Char>
+struct is_range<dbf::FixedString<N>, Char> : std::false_type {};
+
+template <size_t N>
+struct formatter<dbf::FixedString<N>> : formatter<string_view> {
+  template <typename FormatContext>
+  auto format(const dbf::FixedString<N> &p, FormatContext &ctx) const
+      -> decltype(ctx.out()) {
+    return formatter<string_view>::format(string_view(p.data(), p.size()),
+                                          ctx);
+  }
+};
+} // namespace fmt
+
+#endif
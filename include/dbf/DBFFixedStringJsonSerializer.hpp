@@ -0,0 +1,27 @@
+#ifndef DBF_D_B_F_FIXED_STRING_JSON_SERIALIZER_H
+#define DBF_D_B_F_FIXED_STRING_JSON_SERIALIZER_H
+
+#include <stdexcept>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "DBFFixedString.hpp"
+
+namespace nlohmann {
+template <size_t N> struct adl_serializer<dbf::FixedString<N>> {
+  static void from_json(const json &j, dbf::FixedString<N> &msg) {
+    if (!j.is_string()) {
+      throw std::invalid_argument("JSON value is not a string");
+    }
+    const auto &str = j.get_ref<const std::string &>();
+    msg.assign(str.data(), str.size());
+  }
+
+  static void to_json(json &j, const dbf::FixedString<N> &msg) {
+    j = msg.str();
+  }
+};
+} // namespace nlohmann
+
+#endif
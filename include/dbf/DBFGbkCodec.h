@@ -0,0 +1,47 @@
+#ifndef DBF_GBK_CODEC_H
+#define DBF_GBK_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dbf {
+class DBFGbkCodec {
+public:
+  DBFGbkCodec(const DBFGbkCodec &) = delete;
+  DBFGbkCodec &operator=(const DBFGbkCodec &) = delete;
+
+public:
+  static const DBFGbkCodec &instance();
+
+  size_t toUtf8(const char *src, size_t len, char *dst, size_t cap) const;
+  size_t toGbk(const char *src, size_t len, char *dst, size_t cap) const;
+
+  bool valid() const { return valid_; }
+
+  static constexpr size_t maxUtf8Bytes(size_t gbkBytes) {
+    return gbkBytes / 2 * 3 + gbkBytes % 2;
+  }
+
+public:
+  static const size_t npos = static_cast<size_t>(-1);
+
+private:
+  DBFGbkCodec();
+
+  bool build();
+
+private:
+  std::vector<uint16_t> toUnicode_;
+  std::vector<uint16_t> toGbk_;
+  bool valid_;
+
+private:
+  static const unsigned kLeadBegin = 0x81;
+  static const unsigned kLeadEnd = 0xFF;
+  static const unsigned kTrailBegin = 0x40;
+  static const unsigned kTrailEnd = 0xFF;
+};
+} // namespace dbf
+
+#endif // !DBF_GBK_CODEC_H
@@ -0,0 +1,57 @@
+#ifndef DBF_IO_BATCH_H
+#define DBF_IO_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace dbf {
+class DBFFile;
+
+class DBFIoBatch {
+public:
+  DBFIoBatch();
+
+  DBFIoBatch(const DBFIoBatch &) = delete;
+  DBFIoBatch &operator=(const DBFIoBatch &) = delete;
+
+public:
+  size_t prepareRead(DBFFile &file, char *buf, size_t pos, size_t len);
+  size_t prepareWrite(DBFFile &file, const char *buf, size_t pos, size_t len);
+  size_t prepareRecordNumber(DBFFile &file);
+
+  bool submit();
+  bool wait();
+  void clear();
+
+  size_t size() const { return requests_.size(); }
+  bool ok(size_t index) const { return requests_[index].ok; }
+
+private:
+  enum Kind { kRead, kWrite, kRecordNumber };
+
+  struct Request {
+    Kind kind;
+    DBFFile *file;
+    char *buf;
+    const char *writeBuf;
+    size_t pos;
+    size_t len;
+    int32_t recordNumber;
+    bool done;
+    bool ok;
+  };
+
+  size_t prepare(Kind kind, DBFFile &file, char *buf, const char *writeBuf,
+                 size_t pos, size_t len);
+  bool execute(Request &request);
+  void complete(Request &request, bool ok);
+
+private:
+  std::deque<Request> requests_;
+  size_t submitted_;
+  bool failed_;
+};
+} // namespace dbf
+
+#endif // !DBF_IO_BATCH_H
@@ -0,0 +1,39 @@
+#ifndef DBF_LIVE_BITMAP_H
+#define DBF_LIVE_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dbf {
+class DBFLiveBitmap {
+public:
+  DBFLiveBitmap() : size_(0), liveCount_(0) {}
+
+public:
+  void reset(size_t records);
+  size_t scan(const char *data, size_t first, size_t records, size_t stride);
+
+  size_t size() const { return size_; }
+  size_t liveCount() const { return liveCount_; }
+  size_t deletedCount() const { return size_ - liveCount_; }
+  const std::vector<uint64_t> &words() const { return words_; }
+
+  bool live(size_t index) const {
+    return index < size_ && (words_[index / 64] >> (index % 64) & 1) != 0;
+  }
+  size_t nextLive(size_t index) const;
+
+  static bool accelerated();
+
+private:
+  std::vector<uint64_t> words_;
+  size_t size_;
+  size_t liveCount_;
+
+private:
+  static const char kDeleteFlag = 0x2A;
+};
+} // namespace dbf
+
+#endif // !DBF_LIVE_BITMAP_H
@@ -0,0 +1,59 @@
+#ifndef DBF_MAPPING_H
+#define DBF_MAPPING_H
+
+#include <cstddef>
+#include <string>
+
+namespace dbf {
+class DBFMapping {
+public:
+  DBFMapping();
+  ~DBFMapping();
+
+  DBFMapping(const DBFMapping &) = delete;
+  DBFMapping &operator=(const DBFMapping &) = delete;
+
+public:
+  bool open(const std::string &name, bool writable = false);
+  bool close();
+  bool remap();
+  bool resize(size_t size);
+  bool sync();
+
+  bool isOpen() const { return opened_; }
+  bool writable() const { return writable_; }
+  const char *data() const { return data_; }
+  char *data() { return data_; }
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+
+  void markDirty(size_t pos, size_t len);
+  void adviseSequential();
+
+private:
+  bool map(size_t capacity);
+  bool unmap();
+  bool truncate(size_t size);
+
+private:
+  bool opened_;
+  bool writable_;
+  char *data_;
+  size_t size_;
+  size_t capacity_;
+  size_t dirtyBegin_;
+  size_t dirtyEnd_;
+#ifdef _WIN32
+  void *file_;
+  void *mapping_;
+#else
+  int fd_;
+#endif
+
+private:
+  static const size_t kMinGrowBytes = 1024 * 1024;
+  static const size_t kMaxGrowBytes = 64 * 1024 * 1024;
+};
+} // namespace dbf
+
+#endif // !DBF_MAPPING_H
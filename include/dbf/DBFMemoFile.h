@@ -0,0 +1,68 @@
+#ifndef DBF_MEMO_FILE_H
+#define DBF_MEMO_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <boost/utility/string_view.hpp>
+
+#include "DBFBuffer.hpp"
+#include "DBFMapping.h"
+
+namespace dbf {
+class DBFMemoFile {
+public:
+  enum Format { kDbt, kFpt };
+
+public:
+  explicit DBFMemoFile(const std::string &name, Format format = kDbt,
+                       size_t blockBytes = 0);
+  ~DBFMemoFile();
+
+  DBFMemoFile(const DBFMemoFile &) = delete;
+  DBFMemoFile &operator=(const DBFMemoFile &) = delete;
+
+public:
+  bool open(bool writable = false);
+  bool close();
+  bool isOpen() const { return mapping_.isOpen(); }
+
+  // صͼָӳһreadappendflushclose֮ʧЧ
+  // Ҫʱ÷п
+  boost::string_view read(uint32_t block);
+  uint32_t append(const boost::string_view &text);
+  bool flush();
+
+  const std::string &name() const { return name_; }
+  Format format() const { return format_; }
+  size_t blockBytes() const { return blockBytes_; }
+  uint32_t nextBlock() const { return nextBlock_; }
+
+  static std::string memoName(const std::string &dbfName, Format format);
+
+private:
+  bool readHeader();
+  void writeHeader();
+  boost::string_view bytesAt(size_t pos, size_t len);
+
+private:
+  std::string name_;
+  Format format_;
+  size_t blockBytes_;
+  DBFMapping mapping_;
+  DBFBuffer pending_;
+  uint32_t flushedBlock_;
+  uint32_t nextBlock_;
+
+private:
+  static const size_t kHeaderBytes = 512;
+  static const size_t kDbtBlockBytes = 512;
+  static const size_t kFptBlockBytes = 64;
+  static const size_t kFptBlockHeadBytes = 8;
+  static const size_t kBatchBytes = 256 * 1024;
+  static const char kDbtEndFlag = 0x1A;
+};
+} // namespace dbf
+
+#endif // !DBF_MEMO_FILE_H
@@ -17,7 +17,12 @@ public:
 
 public:
   virtual void parseFrom(DBFBuffer &buf) {
-    setRecordDelete(buf.readChar());
+    char recordDelete = buf.readChar();
+    if (!buf.throwOnError() && recordDelete != 0x20 && recordDelete != 0x2A) {
+      buf.fail(DBFStatus::kBadDeleteFlag, "Read record delete tag failed");
+      return;
+    }
+    setRecordDelete(recordDelete);
   }
 
   virtual void serializeTo(DBFBuffer &buf) const {
@@ -0,0 +1,102 @@
+#ifndef DBF_RECORD_BATCH_HPP
+#define DBF_RECORD_BATCH_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "DBFArena.h"
+#include "DBFRecord.h"
+
+namespace dbf {
+/**
+ * @brief  ŵͬͼ¼¼ֵһڴclear/resizeͷ
+ *         ѹļ¼һֱӸǺڲĻȶ״̬²ٷ䡣
+ *         DBFFileдֱӵT::parseFrom/T::serializeToû麯
+ */
+template <typename T> class RecordBatch {
+  static_assert(std::is_base_of<DBFRecord, T>::value,
+                "RecordBatch element must derive from DBFRecord");
+
+public:
+  typedef T value_type;
+  typedef T *iterator;
+  typedef const T *const_iterator;
+
+public:
+  RecordBatch() : size_(0) {}
+  explicit RecordBatch(size_t count) : records_(count), size_(count) {}
+  RecordBatch(size_t count, const T &value)
+      : records_(count, value), size_(count) {}
+
+  /**
+   * @brief  ¼resourceڴ¼allocator_typeʱ
+   *         DBFDynamicRecord¹ļ¼Ҳͬһresource
+   */
+  explicit RecordBatch(pmr::memory_resource *resource)
+      : records_(pmr::polymorphic_allocator<T>(resource)), size_(0) {}
+
+public:
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  // ѹɸõļ¼
+  size_t capacity() const { return records_.size(); }
+
+  void reserve(size_t count) { records_.reserve(count); }
+
+  // ֻıɼļ¼ֱԱ㸴
+  void clear() { size_ = 0; }
+
+  void resize(size_t count) {
+    if (count > records_.size()) {
+      records_.resize(count);
+    }
+    size_ = count;
+  }
+
+  // ¹ļ¼valueûĬϹļ¼
+  void resize(size_t count, const T &value) {
+    if (count > records_.size()) {
+      records_.resize(count, value);
+    }
+    size_ = count;
+  }
+
+  // ȸѹļ¼صļ¼һֵ
+  T &emplace_back() {
+    if (size_ == records_.size()) {
+      records_.emplace_back();
+    }
+    return records_[size_++];
+  }
+
+  void push_back(const T &value) {
+    if (size_ == records_.size()) {
+      records_.push_back(value);
+    } else {
+      records_[size_] = value;
+    }
+    ++size_;
+  }
+
+  T &operator[](size_t index) { return records_[index]; }
+  const T &operator[](size_t index) const { return records_[index]; }
+  T &front() { return records_[0]; }
+  const T &front() const { return records_[0]; }
+  T &back() { return records_[size_ - 1]; }
+  const T &back() const { return records_[size_ - 1]; }
+
+  T *data() { return records_.data(); }
+  const T *data() const { return records_.data(); }
+
+  iterator begin() { return records_.data(); }
+  iterator end() { return records_.data() + size_; }
+  const_iterator begin() const { return records_.data(); }
+  const_iterator end() const { return records_.data() + size_; }
+
+private:
+  pmr::vector<T> records_;
+  size_t size_;
+};
+} // namespace dbf
+
+#endif
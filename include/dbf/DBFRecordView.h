@@ -0,0 +1,196 @@
+#ifndef DBF_RECORD_VIEW_H
+#define DBF_RECORD_VIEW_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/endian/conversion.hpp>
+#include <boost/utility/string_view.hpp>
+#include <util/StringUtil.hpp>
+
+#include "DBFFixedString.hpp"
+#include "DBFGbkCodec.h"
+#include "DBFHeadField.h"
+
+namespace dbf {
+class DBFRecordLayout {
+public:
+  DBFRecordLayout() : recordBytes_(0) {}
+
+  void reset(const std::vector<DBFHeadField> &fields) {
+    offsets_.clear();
+    lengths_.clear();
+    precisions_.clear();
+    size_t offset = 1;
+    for (auto &field : fields) {
+      offsets_.push_back(offset);
+      lengths_.push_back(field.totalLen());
+      precisions_.push_back(field.precisionLen());
+      offset += field.totalLen();
+    }
+    recordBytes_ = offset;
+  }
+
+  size_t fieldCount() const { return offsets_.size(); }
+  size_t offset(size_t index) const { return offsets_[index]; }
+  size_t length(size_t index) const { return lengths_[index]; }
+  size_t precision(size_t index) const { return precisions_[index]; }
+  size_t recordBytes() const { return recordBytes_; }
+
+private:
+  std::vector<size_t> offsets_;
+  std::vector<uint8_t> lengths_;
+  std::vector<uint8_t> precisions_;
+  size_t recordBytes_;
+};
+
+class DBFRecordView {
+public:
+  DBFRecordView() : data_(nullptr), layout_(nullptr), readPos_(0) {}
+  DBFRecordView(const char *data, const DBFRecordLayout *layout,
+                size_t readPos)
+      : data_(data), layout_(layout), readPos_(readPos) {}
+
+public:
+  bool valid() const { return data_ != nullptr && layout_ != nullptr; }
+  const char *data() const { return data_; }
+  size_t size() const { return layout_->recordBytes(); }
+  const DBFRecordLayout *layout() const { return layout_; }
+
+  void setReadPos(size_t readPos) { readPos_ = readPos; }
+  size_t readPos() const { return readPos_; }
+
+  bool recordDelete() const { return data_[0] == 0x2A; }
+  size_t fieldCount() const { return layout_->fieldCount(); }
+
+  boost::string_view rawField(size_t index) const {
+    return boost::string_view(data_ + layout_->offset(index),
+                              layout_->length(index));
+  }
+
+  boost::string_view stringView(size_t index) const {
+    auto view = rawField(index);
+    auto start = view.find_first_not_of(' ');
+    if (start == boost::string_view::npos) {
+      return boost::string_view();
+    }
+    auto end = view.find_last_not_of(' ');
+    return view.substr(start, end - start + 1);
+  }
+
+  std::string readString(size_t index) const {
+    auto view = stringView(index);
+    return std::string(view.data(), view.size());
+  }
+
+  template <size_t Capacity>
+  FixedString<Capacity> readFixedString(size_t index) const {
+    auto view = stringView(index);
+    return FixedString<Capacity>(view.data(), view.size());
+  }
+
+  boost::string_view readUtf8StringView(size_t index, char *dst,
+                                        size_t cap) const {
+    auto view = stringView(index);
+    if (util::isAscii(view.data(), view.size())) {
+      return view;
+    }
+    size_t len =
+        DBFGbkCodec::instance().toUtf8(view.data(), view.size(), dst, cap);
+    if (len == DBFGbkCodec::npos) {
+      throw std::invalid_argument("Malformed gbk field : " +
+                                  readString(index));
+    }
+    return boost::string_view(dst, len);
+  }
+
+  template <typename T> T readInt(size_t index) const {
+    T value(0);
+    if (!util::decimalToInt(data_ + layout_->offset(index),
+                            layout_->length(index), layout_->precision(index),
+                            value)) {
+      throw std::invalid_argument("Malformed numeric field : " +
+                                  readString(index));
+    }
+    return value;
+  }
+
+  double readDouble(size_t index) const {
+    double value = 0;
+    if (!util::decimalToDouble(data_ + layout_->offset(index),
+                               layout_->length(index),
+                               layout_->precision(index), value)) {
+      throw std::invalid_argument("Malformed numeric field : " +
+                                  readString(index));
+    }
+    return value;
+  }
+
+  int32_t readDate(size_t index) const {
+    int32_t days = util::kNullDate;
+    if (!util::dateToDays(data_ + layout_->offset(index),
+                          layout_->length(index), days)) {
+      throw std::invalid_argument("Malformed date field : " +
+                                  readString(index));
+    }
+    return days;
+  }
+
+  util::Logical readLogical(size_t index) const {
+    util::Logical value = util::Logical::kUnknown;
+    if (layout_->length(index) != 1 ||
+        !util::charToLogical(data_[layout_->offset(index)], value)) {
+      throw std::invalid_argument("Malformed logical field : " +
+                                  readString(index));
+    }
+    return value;
+  }
+
+  uint32_t readMemoBlock(size_t index) const {
+    return layout_->length(index) == sizeof(uint32_t)
+               ? readBinary<uint32_t>(index, 0)
+               : readInt<uint32_t>(index);
+  }
+
+  int32_t readBinaryInt32(size_t index) const {
+    return readBinary<int32_t>(index, 0);
+  }
+
+  double readBinaryDouble(size_t index) const {
+    uint64_t bits = readBinary<uint64_t>(index, 0);
+    double val = 0;
+    std::memcpy(&val, &bits, sizeof val);
+    return val;
+  }
+
+  int64_t readBinaryCurrency(size_t index) const {
+    return readBinary<int64_t>(index, 0);
+  }
+
+  int64_t readBinaryDateTime(size_t index) const {
+    return util::julianToMillis(readBinary<int32_t>(index, 0),
+                                readBinary<int32_t>(index, sizeof(int32_t)));
+  }
+
+private:
+  template <typename T> T readBinary(size_t index, size_t skip) const {
+    if (layout_->length(index) < skip + sizeof(T)) {
+      throw std::invalid_argument("Binary field too short : " +
+                                  std::to_string(layout_->length(index)));
+    }
+    T val;
+    std::memcpy(&val, data_ + layout_->offset(index) + skip, sizeof val);
+    return boost::endian::little_to_native(val);
+  }
+
+private:
+  const char *data_;
+  const DBFRecordLayout *layout_;
+  size_t readPos_;
+};
+} // namespace dbf
+
+#endif // !DBF_RECORD_VIEW_H
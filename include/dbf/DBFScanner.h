@@ -0,0 +1,85 @@
+#ifndef DBF_SCANNER_H
+#define DBF_SCANNER_H
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "DBFBuffer.hpp"
+#include "DBFRecordView.h"
+
+namespace dbf {
+class DBFFile;
+class DBFRecord;
+
+class DBFScanner {
+public:
+  class iterator {
+  public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef DBFRecordView value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const DBFRecordView *pointer;
+    typedef const DBFRecordView &reference;
+
+    iterator() : scanner_(nullptr) {}
+    explicit iterator(DBFScanner *scanner) : scanner_(scanner) {}
+
+    reference operator*() const { return scanner_->view_; }
+    pointer operator->() const { return &scanner_->view_; }
+
+    iterator &operator++() {
+      if (!scanner_->next()) {
+        scanner_ = nullptr;
+      }
+      return *this;
+    }
+
+    bool operator==(const iterator &rhs) const {
+      return scanner_ == rhs.scanner_;
+    }
+    bool operator!=(const iterator &rhs) const {
+      return scanner_ != rhs.scanner_;
+    }
+
+  private:
+    DBFScanner *scanner_;
+  };
+
+public:
+  DBFScanner(DBFFile &file, size_t chunkBytes);
+  DBFScanner(DBFScanner &&other);
+  ~DBFScanner();
+
+  DBFScanner(const DBFScanner &) = delete;
+  DBFScanner &operator=(const DBFScanner &) = delete;
+
+public:
+  iterator begin();
+  iterator end() { return iterator(); }
+
+  bool good() const { return !failed_; }
+  bool parse(DBFRecord &record);
+
+private:
+  bool next();
+  bool fill(size_t pos);
+
+private:
+  DBFFile *file_;
+  std::vector<char> chunk_;
+  const char *data_;
+  size_t chunkPos_;
+  size_t chunkLen_;
+  size_t pos_;
+  size_t end_;
+  size_t recordBytes_;
+  DBFRecordView view_;
+  DBFBuffer buf_;
+  bool ownSession_;
+  bool started_;
+  bool failed_;
+};
+} // namespace dbf
+
+#endif // !DBF_SCANNER_H
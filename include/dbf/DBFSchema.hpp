@@ -0,0 +1,468 @@
+#ifndef DBF_SCHEMA_HPP
+#define DBF_SCHEMA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/endian/conversion.hpp>
+#include <spdlog/spdlog.h>
+#include <util/StringUtil.hpp>
+
+#include "DBFFile.h"
+#include "DBFFixedString.hpp"
+#include "DBFHead.h"
+#include "DBFHeadField.h"
+
+/**
+ * @brief  ֶǩC++14ַ֧ģ
+ *          DBF_FIELD_NAME(Code, "CODE"); ֮ DBFField<Code, 'C', 6>
+ */
+#define DBF_FIELD_NAME(Tag, Name)                                              \
+  struct Tag {                                                                 \
+    static const char *name() { return Name; }                                 \
+  }
+
+namespace dbf {
+namespace detail {
+// ֶĬϵȡֵͣN/FСλʱΪdoubleΪint64_t
+template <char Type, size_t Precision> struct DBFFieldValue {
+  static_assert(Type == 'C' || Type == 'N' || Type == 'F' || Type == 'D' ||
+                    Type == 'L' || Type == 'M' || Type == 'I' ||
+                    Type == 'B' || Type == 'Y' || Type == 'T',
+                "unsupported dbf field type");
+  using type = typename std::conditional<
+      Type == 'N' || Type == 'F',
+      typename std::conditional<Precision == 0, int64_t, double>::type,
+      typename std::conditional<
+          Type == 'D' || Type == 'I', int32_t,
+          typename std::conditional<
+              Type == 'L', util::Logical,
+              typename std::conditional<
+                  Type == 'M', uint32_t,
+                  typename std::conditional<Type == 'B', double,
+                                            int64_t>::type>::type>::type>::
+          type>::type;
+};
+
+template <typename T> inline T loadLittle(const char *data) {
+  T value;
+  std::memcpy(&value, data, sizeof value);
+  return boost::endian::little_to_native(value);
+}
+
+template <typename T> inline void storeLittle(char *dst, T value) {
+  value = boost::endian::native_to_little(value);
+  std::memcpy(dst, &value, sizeof value);
+}
+
+template <size_t Len, size_t Precision, typename T>
+inline bool decodeNumeric(const char *data, T &value, std::false_type) {
+  return util::decimalToInt(data, Len, Precision, value);
+}
+
+template <size_t Len, size_t Precision, typename T>
+inline bool decodeNumeric(const char *data, T &value, std::true_type) {
+  double val = 0;
+  if (!util::decimalToDouble(data, Len, Precision, val)) {
+    return false;
+  }
+  value = static_cast<T>(val);
+  return true;
+}
+
+template <size_t Len, size_t Precision, typename T>
+inline bool encodeNumeric(char *dst, T value, std::false_type) {
+  return util::formatDecimal(dst, Len, Precision, value);
+}
+
+template <size_t Len, size_t Precision, typename T>
+inline bool encodeNumeric(char *dst, T value, std::true_type) {
+  return util::formatDouble(dst, Len, Precision, static_cast<double>(value));
+}
+} // namespace detail
+
+// ֶͷɵı룬ȫڹ̶ϲDBFBufferα꣬
+// ɵļ¼Ҳֱʹ
+template <char Type> struct DBFFieldCodec;
+
+template <> struct DBFFieldCodec<'C'> {
+  template <size_t Len, size_t Precision, size_t Capacity>
+  static bool decode(const char *data, FixedString<Capacity> &value) {
+    size_t begin = 0;
+    size_t end = Len;
+    while (begin < end && data[begin] == ' ') {
+      ++begin;
+    }
+    while (end > begin && data[end - 1] == ' ') {
+      --end;
+    }
+    if (end - begin > Capacity) {
+      return false;
+    }
+    value.assign(data + begin, end - begin);
+    return true;
+  }
+
+  template <size_t Len, size_t Precision, size_t Capacity>
+  static bool encode(char *dst, const FixedString<Capacity> &value) {
+    static_assert(Capacity <= Len, "Fixed string capacity exceeds field");
+    std::memcpy(dst, value.data(), value.size());
+    std::memset(dst + value.size(), ' ', Len - value.size());
+    return true;
+  }
+};
+
+template <> struct DBFFieldCodec<'N'> {
+  template <size_t Len, size_t Precision, typename T>
+  static bool decode(const char *data, T &value) {
+    return detail::decodeNumeric<Len, Precision>(data, value,
+                                         std::is_floating_point<T>());
+  }
+
+  template <size_t Len, size_t Precision, typename T>
+  static bool encode(char *dst, T value) {
+    return detail::encodeNumeric<Len, Precision>(dst, value,
+                                         std::is_floating_point<T>());
+  }
+};
+
+template <> struct DBFFieldCodec<'F'> : DBFFieldCodec<'N'> {};
+
+template <> struct DBFFieldCodec<'D'> {
+  template <size_t Len, size_t Precision>
+  static bool decode(const char *data, int32_t &value) {
+    return util::dateToDays(data, Len, value);
+  }
+
+  template <size_t Len, size_t Precision>
+  static bool encode(char *dst, int32_t value) {
+    return util::formatDate(dst, Len, value);
+  }
+};
+
+template <> struct DBFFieldCodec<'L'> {
+  template <size_t Len, size_t Precision>
+  static bool decode(const char *data, util::Logical &value) {
+    static_assert(Len == 1, "logical field length must be 1");
+    return util::charToLogical(*data, value);
+  }
+
+  template <size_t Len, size_t Precision>
+  static bool encode(char *dst, util::Logical value) {
+    *dst = util::logicalToChar(value);
+    return true;
+  }
+};
+
+template <> struct DBFFieldCodec<'M'> {
+  template <size_t Len, size_t Precision>
+  static bool decode(const char *data, uint32_t &value) {
+    if (Len == sizeof(uint32_t)) {
+      value = detail::loadLittle<uint32_t>(data);
+      return true;
+    }
+    return util::decimalToInt(data, Len, 0, value);
+  }
+
+  template <size_t Len, size_t Precision>
+  static bool encode(char *dst, uint32_t value) {
+    if (Len == sizeof(uint32_t)) {
+      detail::storeLittle(dst, value);
+      return true;
+    }
+    if (value == 0) {
+      std::memset(dst, ' ', Len);
+      return true;
+    }
+    return util::formatDecimal(dst, Len, 0, value);
+  }
+};
+
+template <> struct DBFFieldCodec<'I'> {
+  template <size_t Len, size_t Precision>
+  static bool decode(const char *data, int32_t &value) {
+    static_assert(Len == sizeof(int32_t), "I field length must be 4");
+    value = detail::loadLittle<int32_t>(data);
+    return true;
+  }
+
+  template <size_t Len, size_t Precision>
+  static bool encode(char *dst, int32_t value) {
+    detail::storeLittle(dst, value);
+    return true;
+  }
+};
+
+template <> struct DBFFieldCodec<'B'> {
+  template <size_t Len, size_t Precision>
+  static bool decode(const char *data, double &value) {
+    static_assert(Len == sizeof(double), "B field length must be 8");
+    uint64_t bits = detail::loadLittle<uint64_t>(data);
+    std::memcpy(&value, &bits, sizeof value);
+    return true;
+  }
+
+  template <size_t Len, size_t Precision>
+  static bool encode(char *dst, double value) {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof bits);
+    detail::storeLittle(dst, bits);
+    return true;
+  }
+};
+
+template <> struct DBFFieldCodec<'Y'> {
+  template <size_t Len, size_t Precision>
+  static bool decode(const char *data, int64_t &value) {
+    static_assert(Len == sizeof(int64_t), "Y field length must be 8");
+    value = detail::loadLittle<int64_t>(data);
+    return true;
+  }
+
+  template <size_t Len, size_t Precision>
+  static bool encode(char *dst, int64_t value) {
+    detail::storeLittle(dst, value);
+    return true;
+  }
+};
+
+template <> struct DBFFieldCodec<'T'> {
+  template <size_t Len, size_t Precision>
+  static bool decode(const char *data, int64_t &value) {
+    static_assert(Len == 2 * sizeof(int32_t), "T field length must be 8");
+    value = util::julianToMillis(
+        detail::loadLittle<int32_t>(data),
+        detail::loadLittle<int32_t>(data + sizeof(int32_t)));
+    return true;
+  }
+
+  template <size_t Len, size_t Precision>
+  static bool encode(char *dst, int64_t value) {
+    int32_t day = 0;
+    int32_t millis = 0;
+    util::millisToJulian(value, day, millis);
+    detail::storeLittle(dst, day);
+    detail::storeLittle(dst + sizeof(int32_t), millis);
+    return true;
+  }
+};
+
+namespace detail {
+template <size_t... Lens> struct DBFFieldOffsets {
+  // Indexֶεƫƣ¼ֽɾ־
+  static constexpr size_t offset(size_t index) {
+    constexpr size_t lens[] = {Lens..., 0};
+    size_t offset = 1;
+    for (size_t i = 0; i < index; ++i) {
+      offset += lens[i];
+    }
+    return offset;
+  }
+};
+} // namespace detail
+
+/**
+ * @brief  ֶNameΪDBF_FIELD_NAMEıǩTΪͣ
+ *         CֶĬFixedString<Len>NֶСλĬdoubleint64_t
+ *         Ҳָ͵õŴ10^PrecisionĶֵ
+ */
+template <typename Name, char Type, size_t Len, size_t Precision = 0,
+          typename T = typename std::conditional<
+              Type == 'C', FixedString<Len>,
+              typename detail::DBFFieldValue<Type, Precision>::type>::type>
+struct DBFField {
+  static_assert(Len > 0 && Len <= UINT8_MAX, "field length must be in [1, 255]");
+
+  using value_type = T;
+  static constexpr char kType = Type;
+  static constexpr size_t kLength = Len;
+  static constexpr size_t kPrecision = Precision;
+
+  static const char *name() { return Name::name(); }
+
+  static bool decode(const char *data, T &value) {
+    return DBFFieldCodec<Type>::template decode<Len, Precision>(data,
+                                                                        value);
+  }
+
+  static bool encode(char *dst, const T &value) {
+    return DBFFieldCodec<Type>::template encode<Len, Precision>(dst,
+                                                                        value);
+  }
+};
+
+template <typename Name, char Type, size_t Len, size_t Precision, typename T>
+constexpr char DBFField<Name, Type, Len, Precision, T>::kType;
+template <typename Name, char Type, size_t Len, size_t Precision, typename T>
+constexpr size_t DBFField<Name, Type, Len, Precision, T>::kLength;
+template <typename Name, char Type, size_t Len, size_t Precision, typename T>
+constexpr size_t DBFField<Name, Type, Len, Precision, T>::kPrecision;
+
+/**
+ * @brief  ڼ¼ṹֶƫơȺͱڱȷ
+ *         һ¼ڹ̶ƫϵֱߴ룬û麯ã
+ *         CֶFixedStringʱ¼Ľ벻ڴ
+ */
+template <typename... Fields> class DBFSchema {
+public:
+  using Row = std::tuple<typename Fields::value_type...>;
+  template <size_t Index>
+  using FieldAt = typename std::tuple_element<Index, std::tuple<Fields...>>::type;
+
+  static constexpr size_t kFieldCount = sizeof...(Fields);
+  static constexpr size_t kRecordBytes =
+      detail::DBFFieldOffsets<Fields::kLength...>::offset(kFieldCount);
+
+  template <size_t Index> static constexpr size_t offset() {
+    return detail::DBFFieldOffsets<Fields::kLength...>::offset(Index);
+  }
+
+public:
+  static bool recordDelete(const char *record) { return record[0] == 0x2A; }
+
+  // һ¼recordָɾ־ʽֶηfalse
+  static bool decode(const char *record, Row &row) {
+    if (record[0] != 0x20 && record[0] != 0x2A) {
+      return false;
+    }
+    return decodeFields(record, row, std::index_sequence_for<Fields...>());
+  }
+
+  /**
+   * @brief  һļ¼count
+   *         سɹʽļ¼ֹͣ
+   */
+  static size_t decode(const char *data, size_t bytes, Row *rows,
+                       size_t count) {
+    size_t records = std::min(bytes / kRecordBytes, count);
+    for (size_t index = 0; index < records; ++index) {
+      if (!decode(data + index * kRecordBytes, rows[index])) {
+        return index;
+      }
+    }
+    return records;
+  }
+
+  // 뵽rowsrowsڶε֮临
+  static size_t decode(const char *data, size_t bytes,
+                       std::vector<Row> &rows) {
+    rows.resize(bytes / kRecordBytes);
+    size_t records = decode(data, bytes, rows.data(), rows.size());
+    rows.resize(records);
+    return records;
+  }
+
+  static bool decode(const DBFRecordView &view, Row &row) {
+    return decode(view.data(), row);
+  }
+
+  // һ¼recordҪkRecordBytesֽ
+  static bool encode(const Row &row, char *record,
+                     bool recordDelete = false) {
+    record[0] = recordDelete ? 0x2A : 0x20;
+    return encodeFields(row, record, std::index_sequence_for<Fields...>());
+  }
+
+  static size_t encode(const Row *rows, size_t count, char *data,
+                       size_t bytes) {
+    size_t records = std::min(bytes / kRecordBytes, count);
+    for (size_t index = 0; index < records; ++index) {
+      if (!encode(rows[index], data + index * kRecordBytes)) {
+        return index;
+      }
+    }
+    return records;
+  }
+
+  // ṹļ׷ֶ½ļ
+  static void appendHeadFields(DBFFile &file) {
+    (void)std::initializer_list<int>{
+        (file.appendHeadField(Fields::name(), std::string(1, Fields::kType),
+                              static_cast<uint8_t>(Fields::kLength),
+                              static_cast<uint8_t>(Fields::kPrecision)),
+         0)...};
+  }
+
+  // readHead֮ļͷṹһ£һʱ־false
+  static bool matches(const DBFFile &file) {
+    const auto &fields = file.headFields();
+    if (fields.size() != kFieldCount) {
+      SPDLOG_WARN("Schema field count error {} != {}", fields.size(),
+                  kFieldCount);
+      return false;
+    }
+    if (file.head() != nullptr &&
+        static_cast<size_t>(file.head()->recordBytes()) != kRecordBytes) {
+      SPDLOG_WARN("Schema record bytes error {} != {}",
+                  file.head()->recordBytes(), kRecordBytes);
+      return false;
+    }
+    bool ok = true;
+    size_t index = 0;
+    (void)std::initializer_list<int>{
+        (ok = ok && matchField<Fields>(fields[index++]), 0)...};
+    return ok;
+  }
+
+private:
+  template <typename Field> static bool matchField(const DBFHeadField &field) {
+    if (field.name() != Field::name()) {
+      SPDLOG_WARN("Schema field name error {} != {}", field.name(),
+                  Field::name());
+      return false;
+    }
+    if (field.filedType() != std::string(1, Field::kType)) {
+      SPDLOG_WARN("Schema field type error {} != {}", field.filedType(),
+                  Field::kType);
+      return false;
+    }
+    if (field.totalLen() != Field::kLength) {
+      SPDLOG_WARN("Schema field total len error {} : {} != {}", field.name(),
+                  field.totalLen(), Field::kLength);
+      return false;
+    }
+    if (field.precisionLen() != Field::kPrecision) {
+      SPDLOG_WARN("Schema field precision len error {} : {} != {}",
+                  field.name(), field.precisionLen(), Field::kPrecision);
+      return false;
+    }
+    return true;
+  }
+
+  template <size_t... Index>
+  static bool decodeFields(const char *record, Row &row,
+                           std::index_sequence<Index...>) {
+    bool ok = true;
+    (void)std::initializer_list<int>{
+        (ok &= FieldAt<Index>::decode(record + offset<Index>(),
+                                      std::get<Index>(row)),
+         0)...};
+    return ok;
+  }
+
+  template <size_t... Index>
+  static bool encodeFields(const Row &row, char *record,
+                           std::index_sequence<Index...>) {
+    bool ok = true;
+    (void)std::initializer_list<int>{
+        (ok &= FieldAt<Index>::encode(record + offset<Index>(),
+                                      std::get<Index>(row)),
+         0)...};
+    return ok;
+  }
+};
+
+template <typename... Fields> constexpr size_t DBFSchema<Fields...>::kFieldCount;
+template <typename... Fields>
+constexpr size_t DBFSchema<Fields...>::kRecordBytes;
+} // namespace dbf
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef DBF_STORAGE_H
+#define DBF_STORAGE_H
+
+#include <cstddef>
+#include <cstdio>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "DBFMapping.h"
+
+namespace dbf {
+class DBFStorage {
+public:
+  virtual ~DBFStorage() {}
+
+public:
+  virtual bool read(char *buf, size_t len, size_t pos) = 0;
+  virtual bool write(const char *buf, size_t len, size_t pos) = 0;
+  virtual bool truncate(size_t len) = 0;
+  virtual bool reserve(size_t) { return true; }
+  virtual bool sync() { return true; }
+  virtual bool close() { return true; }
+
+  virtual bool contiguous() const { return false; }
+  virtual bool seekable() const { return true; }
+  virtual const char *data(size_t, size_t) { return nullptr; }
+  virtual int fd() const { return -1; }
+  virtual void adviseSequential(size_t, size_t) {}
+  virtual void adviseWillNeed(size_t, size_t) {}
+};
+
+class DBFFileStorage : public DBFStorage {
+public:
+  DBFFileStorage();
+  ~DBFFileStorage();
+
+public:
+  bool open(const std::string &name, bool readOnly);
+
+  virtual bool read(char *buf, size_t len, size_t pos) override;
+  virtual bool write(const char *buf, size_t len, size_t pos) override;
+  virtual bool truncate(size_t len) override;
+  virtual bool reserve(size_t len) override;
+  virtual bool sync() override;
+  virtual bool close() override;
+
+  virtual int fd() const override;
+  virtual void adviseSequential(size_t pos, size_t len) override;
+  virtual void adviseWillNeed(size_t pos, size_t len) override;
+
+private:
+#ifdef _WIN32
+  FILE *file_;
+#else
+  int fd_;
+#endif
+};
+
+class DBFMapStorage : public DBFStorage {
+public:
+  bool open(const std::string &name, bool writable);
+
+  virtual bool read(char *buf, size_t len, size_t pos) override;
+  virtual bool write(const char *buf, size_t len, size_t pos) override;
+  virtual bool truncate(size_t len) override;
+  virtual bool reserve(size_t len) override;
+  virtual bool sync() override { return mapping_.sync(); }
+  virtual bool close() override { return mapping_.close(); }
+
+  virtual bool contiguous() const override { return true; }
+  virtual const char *data(size_t pos, size_t len) override;
+  virtual void adviseSequential(size_t, size_t) override {
+    mapping_.adviseSequential();
+  }
+
+private:
+  DBFMapping mapping_;
+};
+
+class DBFMemoryStorage : public DBFStorage {
+public:
+  DBFMemoryStorage();
+  explicit DBFMemoryStorage(std::vector<char> bytes);
+  DBFMemoryStorage(const char *data, size_t len);
+
+public:
+  virtual bool read(char *buf, size_t len, size_t pos) override;
+  virtual bool write(const char *buf, size_t len, size_t pos) override;
+  virtual bool truncate(size_t len) override;
+  virtual bool reserve(size_t len) override;
+
+  virtual bool contiguous() const override { return true; }
+  virtual const char *data(size_t pos, size_t len) override;
+
+  const std::vector<char> &bytes() const { return bytes_; }
+  std::vector<char> &bytes() { return bytes_; }
+
+private:
+  std::vector<char> bytes_;
+  const char *borrowed_;
+  size_t borrowedLen_;
+};
+
+class DBFStreamStorage : public DBFStorage {
+public:
+  explicit DBFStreamStorage(std::istream &in);
+  explicit DBFStreamStorage(std::ostream &out);
+
+public:
+  virtual bool read(char *buf, size_t len, size_t pos) override;
+  virtual bool write(const char *buf, size_t len, size_t pos) override;
+  virtual bool truncate(size_t len) override;
+  virtual bool sync() override;
+
+  virtual bool seekable() const override { return false; }
+
+private:
+  bool fetch(char *buf, size_t len);
+
+private:
+  std::istream *in_;
+  std::ostream *out_;
+  size_t pos_;
+  std::vector<char> history_;
+
+private:
+  static const size_t kHistoryBytes = 64 * 1024;
+};
+} // namespace dbf
+
+#endif // !DBF_STORAGE_H
@@ -0,0 +1,74 @@
+#ifndef DBF_TABLE_H
+#define DBF_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <boost/utility/string_view.hpp>
+
+#include "DBFHeadField.h"
+#include "DBFRecordView.h"
+
+namespace dbf {
+/**
+ * @brief  ʱıṹreadHeadֶɣԤÿֶε
+ *         ƫơȡֵͰֲҵĹϣֶO(1)Ҳڴ棬
+ *         ֱȽϲASCIIСд
+ */
+class DBFTable {
+public:
+  enum Kind {
+    kString,
+    kInteger,
+    kDecimal,
+    kDate,
+    kLogical,
+    kMemo,
+    kBinaryInt,
+    kBinaryDouble,
+    kCurrency,
+    kDateTime,
+    kUnknown
+  };
+
+  static const size_t npos = static_cast<size_t>(-1);
+
+public:
+  DBFTable() : mask_(0) {}
+  explicit DBFTable(const std::vector<DBFHeadField> &fields) : mask_(0) {
+    reset(fields);
+  }
+
+public:
+  void reset(const std::vector<DBFHeadField> &fields);
+
+  size_t indexOf(const boost::string_view &name) const;
+  bool contains(const boost::string_view &name) const {
+    return indexOf(name) != npos;
+  }
+
+  size_t fieldCount() const { return fields_.size(); }
+  const DBFHeadField &field(size_t index) const { return fields_[index]; }
+  const std::vector<DBFHeadField> &fields() const { return fields_; }
+  Kind kind(size_t index) const { return kinds_[index]; }
+  const DBFRecordLayout &layout() const { return layout_; }
+  size_t recordBytes() const { return layout_.recordBytes(); }
+
+private:
+  static Kind kindOf(const DBFHeadField &field);
+  static size_t hash(const boost::string_view &name);
+  static bool equals(const boost::string_view &lhs,
+                     const boost::string_view &rhs);
+
+private:
+  std::vector<DBFHeadField> fields_;
+  std::vector<Kind> kinds_;
+  DBFRecordLayout layout_;
+  // Ѱֶַ±һ0ʾղ
+  std::vector<uint16_t> slots_;
+  size_t mask_;
+};
+} // namespace dbf
+
+#endif
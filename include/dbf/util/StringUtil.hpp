@@ -5,11 +5,25 @@
 #include <array>
 #include <algorithm>
 #include <cstdint>
+#include <climits>
+#include <limits>
 #include <cstring>
 #include <cmath>
+#include <cstdio>
 #include <cassert>
 #include <type_traits>
 
+#if defined(__SSE2__) || defined(_M_X64) ||                                   \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DBF_DECIMAL_SSE2 1
+#else
+#define DBF_DECIMAL_SSE2 0
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 #include <spdlog/spdlog.h>
 #include <boost/utility/string_view.hpp>
 #include <boost/lexical_cast.hpp>
@@ -191,6 +205,742 @@ inline T floatStringViewToInt(const boost::string_view &view) {
   }
 }
 
+namespace detail {
+static const uint64_t kPow10[20] = {1ULL,
+                                   10ULL,
+                                   100ULL,
+                                   1000ULL,
+                                   10000ULL,
+                                   100000ULL,
+                                   1000000ULL,
+                                   10000000ULL,
+                                   100000000ULL,
+                                   1000000000ULL,
+                                   10000000000ULL,
+                                   100000000000ULL,
+                                   1000000000000ULL,
+                                   10000000000000ULL,
+                                   100000000000000ULL,
+                                   1000000000000000ULL,
+                                   10000000000000000ULL,
+                                   100000000000000000ULL,
+                                   1000000000000000000ULL,
+                                   10000000000000000000ULL};
+
+// 5^kģ2^64ĳ˷Ԫxܱ10^kʱ x / 10^k == (x >> k) * kInvPow5[k]
+static const uint64_t kInvPow5[17] = {
+    0x0000000000000001ULL, 0xCCCCCCCCCCCCCCCDULL, 0x8F5C28F5C28F5C29ULL,
+    0x1CAC083126E978D5ULL, 0xD288CE703AFB7E91ULL, 0x5D4E8FB00BCBE61DULL,
+    0x790FB65668C26139ULL, 0xE5032477AE8D46A5ULL, 0xC767074B22E90E21ULL,
+    0x8E47CE423A2E9C6DULL, 0x4FA7F60D3ED61F49ULL, 0x0FEE64690C913975ULL,
+    0x3662E0E1CF503EB1ULL, 0xA47A2CF9F6433FBDULL, 0x54186F653140A659ULL,
+    0x7738164770402145ULL, 0xE4A4D1417CD9A041ULL};
+
+inline unsigned countTrailingZeros(uint32_t val) {
+#ifdef _MSC_VER
+  unsigned long index = 0;
+  _BitScanForward(&index, val);
+  return index;
+#else
+  return static_cast<unsigned>(__builtin_ctz(val));
+#endif
+}
+
+inline unsigned countLeadingZeros(uint32_t val) {
+#ifdef _MSC_VER
+  unsigned long index = 0;
+  _BitScanReverse(&index, val);
+  return 31 - index;
+#else
+  return static_cast<unsigned>(__builtin_clz(val));
+#endif
+}
+
+// 8ASCIIһתSWARֽΪλ
+inline uint64_t parseEightDigits(uint64_t val) {
+  val -= 0x3030303030303030ULL;
+  val = (val * 10) + (val >> 8);
+  val = (((val & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+         (((val >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >>
+        32;
+  return val;
+}
+
+// ÷֤len19
+inline uint64_t parseDigits(const char *p, size_t len) {
+  uint64_t val = 0;
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  for (; len >= 8; len -= 8, p += 8) {
+    uint64_t word = 0;
+    std::memcpy(&word, p, sizeof word);
+    val = val * 100000000ULL + parseEightDigits(word);
+  }
+#endif
+  for (; len > 0; --len, ++p) {
+    val = val * 10 + static_cast<uint64_t>(*p - '0');
+  }
+  return val;
+}
+
+inline void scalarClassify(const char *data, size_t len, uint32_t &space,
+                           uint32_t &digit, uint32_t &dot, uint32_t &sign) {
+  space = digit = dot = sign = 0;
+  for (size_t index = 0; index != len; ++index) {
+    char ch = data[index];
+    uint32_t bit = 1u << index;
+    space |= ch == ' ' ? bit : 0;
+    digit |= static_cast<unsigned char>(ch - '0') < 10 ? bit : 0;
+    dot |= ch == '.' ? bit : 0;
+    sign |= (ch == '-' || ch == '+') ? bit : 0;
+  }
+}
+
+#if DBF_DECIMAL_SSE2
+// 16ֽڵֶΣֻҪ16ֽڼزҳͿ԰ȫض붪
+inline bool canLoad16(const char *data, size_t len) {
+#if defined(__SANITIZE_ADDRESS__)
+  return len >= 16;
+#else
+  return len >= 16 || (reinterpret_cast<uintptr_t>(data) & 4095) <= 4096 - 16;
+#endif
+}
+
+inline void sseClassify(__m128i val, uint32_t &space, uint32_t &digit,
+                        uint32_t &dot, uint32_t &sign) {
+  space = static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(val, _mm_set1_epi8(' '))));
+  digit = static_cast<uint32_t>(_mm_movemask_epi8(
+      _mm_and_si128(_mm_cmpgt_epi8(val, _mm_set1_epi8('0' - 1)),
+                    _mm_cmplt_epi8(val, _mm_set1_epi8('9' + 1)))));
+  dot = static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(val, _mm_set1_epi8('.'))));
+  sign = static_cast<uint32_t>(_mm_movemask_epi8(
+      _mm_or_si128(_mm_cmpeq_epi8(val, _mm_set1_epi8('-')),
+                   _mm_cmpeq_epi8(val, _mm_set1_epi8('+')))));
+}
+
+/**
+ * @brief  16ֽڵһתС֮ǰֽһλС㣬
+ *         [begin, end)֮'0'̶λȨvalue * 10^(16 - end)
+ *         ó˷Ԫȷ10^(16 - end)
+ *
+ * @param dotPos СλãûСʱΪ16
+ * @param begin С֮һֵλ
+ * @param end С֮һֵһλ
+ */
+inline uint64_t sseDigits(__m128i val, unsigned dotPos, unsigned begin,
+                          unsigned end) {
+  const __m128i index =
+      _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  if (dotPos < 16) {
+    __m128i before = _mm_cmplt_epi8(
+        index, _mm_set1_epi8(static_cast<char>(dotPos + 1)));
+    val = _mm_or_si128(_mm_and_si128(before, _mm_slli_si128(val, 1)),
+                       _mm_andnot_si128(before, val));
+  }
+  __m128i keep = _mm_and_si128(
+      _mm_cmpgt_epi8(index, _mm_set1_epi8(static_cast<char>(begin) - 1)),
+      _mm_cmplt_epi8(index, _mm_set1_epi8(static_cast<char>(end))));
+  val = _mm_or_si128(_mm_and_si128(keep, val),
+                     _mm_andnot_si128(keep, _mm_set1_epi8('0')));
+
+  uint64_t words[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(words), val);
+  uint64_t scaled =
+      parseEightDigits(words[0]) * 100000000ULL + parseEightDigits(words[1]);
+  unsigned shift = 16 - end;
+  return (scaled >> shift) * kInvPow5[shift];
+}
+#endif
+
+// val * 10 + digituint64_tʱfalse
+inline bool appendDigit(uint64_t &val, unsigned digit) {
+  if (val > (UINT64_MAX - digit) / 10) {
+    return false;
+  }
+  val = val * 10 + digit;
+  return true;
+}
+
+inline bool decimalMagnitudeScalar(const char *data, size_t len,
+                                   size_t precision, uint64_t &magnitude,
+                                   bool &negative) {
+  size_t start = 0;
+  while (start != len && data[start] == ' ') {
+    ++start;
+  }
+  while (len != start && data[len - 1] == ' ') {
+    --len;
+  }
+  magnitude = 0;
+  negative = false;
+  if (start == len) {
+    return true;
+  }
+
+  negative = data[start] == '-';
+  if (data[start] == '-' || data[start] == '+') {
+    ++start;
+  }
+  uint64_t val = 0;
+  size_t index = start;
+  for (; index != len && data[index] != '.'; ++index) {
+    auto digit = static_cast<unsigned char>(data[index] - '0');
+    if (digit >= 10 || !appendDigit(val, digit)) {
+      return false;
+    }
+  }
+  bool hasDigit = index != start;
+  if (index != len) {
+    ++index;
+  }
+  for (size_t digits = 0; digits != precision; ++digits) {
+    unsigned char digit = 0;
+    if (index != len) {
+      digit = static_cast<unsigned char>(data[index] - '0');
+      if (digit >= 10) {
+        return false;
+      }
+      hasDigit = true;
+      ++index;
+    }
+    if (!appendDigit(val, digit)) {
+      return false;
+    }
+  }
+  for (; index != len; ++index) {
+    if (static_cast<unsigned char>(data[index] - '0') >= 10) {
+      return false;
+    }
+    hasDigit = true;
+  }
+  if (!hasDigit) {
+    return false;
+  }
+  magnitude = val;
+  return true;
+}
+
+/**
+ * @brief  ŰѾֵխTTķΧ޷ʱfalse
+ */
+template <typename T>
+inline bool narrowDecimal(uint64_t magnitude, bool negative, T &value) {
+  static_assert(std::is_integral<T>::value, "decimalToInt needs integer type");
+  const auto maxValue = static_cast<uint64_t>(std::numeric_limits<T>::max());
+  if (std::is_unsigned<T>::value) {
+    if (negative || magnitude > maxValue) {
+      return false;
+    }
+    value = static_cast<T>(magnitude);
+    return true;
+  }
+  if (magnitude > maxValue + (negative ? 1 : 0)) {
+    return false;
+  }
+  // ȡmagnitude - 1෴ټ1TСֵҲ
+  value = negative && magnitude != 0
+              ? static_cast<T>(-static_cast<T>(magnitude - 1) - 1)
+              : static_cast<T>(magnitude);
+  return true;
+}
+
+/**
+ * @brief  decimalToIntdecimalToDoubleõĽõŴľֵͷţ
+ *         uint64_tʱfalse
+ */
+inline bool decimalMagnitude(const char *data, size_t len, size_t precision,
+                             uint64_t &magnitude, bool &negative) {
+  if (len > 32 || precision >= 20) {
+    return decimalMagnitudeScalar(data, len, precision, magnitude, negative);
+  }
+
+  uint32_t space, digit, dot, sign;
+#if DBF_DECIMAL_SSE2
+  __m128i head = _mm_setzero_si128(), tail = _mm_setzero_si128();
+  bool vector = canLoad16(data, len);
+  if (vector) {
+    head = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    sseClassify(head, space, digit, dot, sign);
+    if (len > 16) {
+      uint32_t sp, dg, dt, sg;
+      tail = _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(data + len - 16));
+      sseClassify(tail, sp, dg, dt, sg);
+      space |= sp << (len - 16);
+      digit |= dg << (len - 16);
+      dot |= dt << (len - 16);
+      sign |= sg << (len - 16);
+    }
+  } else {
+    scalarClassify(data, len, space, digit, dot, sign);
+  }
+#else
+  scalarClassify(data, len, space, digit, dot, sign);
+#endif
+
+  uint32_t all = len == 32 ? 0xFFFFFFFFu : (1u << len) - 1;
+  uint32_t content = ~space & all;
+  magnitude = 0;
+  negative = false;
+  if (content == 0) {
+    return true;
+  }
+
+  unsigned start = countTrailingZeros(content);
+  unsigned end = 32 - countLeadingZeros(content);
+  uint32_t range =
+      (end == 32 ? 0xFFFFFFFFu : (1u << end) - 1) & ~((1u << start) - 1);
+  uint32_t leadSign = sign & (1u << start);
+  uint32_t dots = dot & range;
+  if ((range & ~(digit | dots | leadSign)) != 0 || (dots & (dots - 1)) != 0 ||
+      (digit & range) == 0) {
+    return false;
+  }
+
+  unsigned intBegin = start + (leadSign != 0 ? 1 : 0);
+  unsigned intEnd = dots != 0 ? countTrailingZeros(dots) : end;
+  if (intEnd - intBegin + precision > 19) {
+    // ܳuint64_tλı汾
+    return decimalMagnitudeScalar(data, len, precision, magnitude, negative);
+  }
+  negative = leadSign != 0 && data[start] == '-';
+  size_t fracLen = dots != 0 ? end - intEnd - 1 : 0;
+  fracLen = std::min(fracLen, precision);
+
+  uint64_t val = 0;
+#if DBF_DECIMAL_SSE2
+  if (vector && end - start <= 16) {
+    unsigned base = len > 16 ? std::min(start, static_cast<unsigned>(len - 16))
+                             : 0;
+    __m128i field =
+        base == 0 ? head
+                  : (base == len - 16
+                         ? tail
+                         : _mm_loadu_si128(
+                               reinterpret_cast<const __m128i *>(data + base)));
+    unsigned dotPos = dots != 0 ? intEnd - base : 16;
+    unsigned begin = intBegin - base + (dots != 0 ? 1 : 0);
+    unsigned digitEnd =
+        (dots != 0 ? intEnd - base + 1 : end - base) + static_cast<unsigned>(fracLen);
+    val = sseDigits(field, dotPos, begin, digitEnd);
+  } else
+#endif
+  {
+    val = parseDigits(data + intBegin, intEnd - intBegin);
+    val = val * kPow10[fracLen] + parseDigits(data + intEnd + 1, fracLen);
+  }
+  magnitude = val * kPow10[precision - fracLen];
+  return true;
+}
+} // namespace detail
+
+/**
+ * @brief  ոʮֶΣprecisionλСŴ
+ *         Сλضϣȫո񷵻0ֶԭλ
+ *         SSE2ֶηɿո//С/λУͶλ
+ *         Чֲ16ֽʱҲĴһת
+ *         ַǷַС㡢Ųڿͷû֡
+ *         TķΧ޷ʹʱfalse
+ */
+template <typename T>
+inline bool decimalToInt(const char *data, size_t len, size_t precision,
+                         T &value) {
+  uint64_t magnitude = 0;
+  bool negative = false;
+  value = 0;
+  return detail::decimalMagnitude(data, len, precision, magnitude, negative) &&
+         detail::narrowDecimal(magnitude, negative, value);
+}
+
+namespace detail {
+static const char kDigitPairs[201] = "00010203040506070809"
+                                     "10111213141516171819"
+                                     "20212223242526272829"
+                                     "30313233343536373839"
+                                     "40414243444546474849"
+                                     "50515253545556575859"
+                                     "60616263646566676869"
+                                     "70717273747576777879"
+                                     "80818283848586878889"
+                                     "90919293949596979899";
+
+inline size_t countDigits(uint64_t val) {
+  size_t digits = 1;
+  while (digits < 20 && val >= kPow10[digits]) {
+    ++digits;
+  }
+  return digits;
+}
+
+// endǰдvalĵdigitsλ㲹0ÿβдλ
+inline char *writeDigits(char *end, uint64_t val, size_t digits) {
+  for (; digits >= 2; digits -= 2) {
+    end -= 2;
+    std::memcpy(end, kDigitPairs + (val % 100) * 2, 2);
+    val /= 100;
+  }
+  if (digits > 0) {
+    *--end = static_cast<char>('0' + val % 10);
+  }
+  return end;
+}
+} // namespace detail
+
+/**
+ * @brief  valprecisionλСʽҶ롢ಹոֱдdstlenֽڣ
+ *         м仺ȲʱfalseҲдdst
+ */
+template <typename T>
+inline bool formatDecimal(char *dst, size_t len, size_t precision, T val) {
+  bool negative = val < 0;
+  uint64_t value = negative ? 0 - static_cast<uint64_t>(val)
+                            : static_cast<uint64_t>(val);
+  if (precision >= 20) {
+    return false;
+  }
+
+  uint64_t integerPart = value;
+  uint64_t floatPart = 0;
+  if (precision > 0) {
+    integerPart = value / detail::kPow10[precision];
+    floatPart = value % detail::kPow10[precision];
+  }
+  size_t intDigits = detail::countDigits(integerPart);
+  size_t size = intDigits + (precision > 0 ? precision + 1 : 0) +
+                (negative ? 1 : 0);
+  if (size > len) {
+    return false;
+  }
+
+  char *end = dst + len;
+  if (precision > 0) {
+    end = detail::writeDigits(end, floatPart, precision);
+    *--end = '.';
+  }
+  end = detail::writeDigits(end, integerPart, intDigits);
+  if (negative) {
+    *--end = '-';
+  }
+  std::memset(dst, ' ', static_cast<size_t>(end - dst));
+  return true;
+}
+
+namespace detail {
+// 10^0 ~ 10^22doubleȷʾ
+static const double kPow10Double[23] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+const uint64_t kMaxExactInt = 1ULL << 53;
+
+inline unsigned countLeadingZeros64(uint64_t val) {
+#ifdef _MSC_VER
+  unsigned long index = 0;
+#ifdef _M_X64
+  _BitScanReverse64(&index, val);
+#else
+  if (_BitScanReverse(&index, static_cast<uint32_t>(val >> 32))) {
+    index += 32;
+  } else {
+    _BitScanReverse(&index, static_cast<uint32_t>(val));
+  }
+#endif
+  return 63 - index;
+#else
+  return static_cast<unsigned>(__builtin_clzll(val));
+#endif
+}
+
+/**
+ * @brief  ӽ val / 10^precision doubleval2^53ʱ
+ *         Ǿȷģһγȷ룻10^precision
+ *         5^precision * 2^precision64λ55λ̺
+ *         ٰͽż뵽53λ
+ */
+inline double scaleDown(uint64_t val, size_t precision) {
+  if (val <= kMaxExactInt) {
+    return static_cast<double>(val) / kPow10Double[precision];
+  }
+
+  uint64_t divisor = kPow10[precision] >> precision; // 5^precision < 2^45
+  uint64_t quotient = val / divisor;
+  uint64_t remainder = val % divisor;
+  int shift = 0;
+  while (quotient < (1ULL << 55)) {
+    remainder <<= 8;
+    quotient = (quotient << 8) | (remainder / divisor);
+    remainder %= divisor;
+    shift += 8;
+  }
+
+  unsigned drop = 11 - countLeadingZeros64(quotient);
+  uint64_t mantissa = quotient >> drop;
+  uint64_t rest = quotient & ((1ULL << drop) - 1);
+  uint64_t half = 1ULL << (drop - 1);
+  if (rest > half || (rest == half && (remainder != 0 || (mantissa & 1)))) {
+    ++mantissa;
+  }
+  return std::ldexp(static_cast<double>(mantissa),
+                    static_cast<int>(drop) - shift -
+                        static_cast<int>(precision));
+}
+} // namespace detail
+
+/**
+ * @brief  ʮֶΪdoubledecimalToIntͬprecision
+ *         СλضϣȫոΪ0ضϺıӽdouble
+ *         תٳ10ݴĶ롣
+ *         uint64_tŴľֵټӷţ1920λֶβ
+ *         int64_tţuint64_tʱfalse
+ */
+inline bool decimalToDouble(const char *data, size_t len, size_t precision,
+                            double &value) {
+  value = 0;
+  if (precision >= 20) {
+    return false;
+  }
+  uint64_t magnitude = 0;
+  bool negative = false;
+  if (!detail::decimalMagnitude(data, len, precision, magnitude, negative)) {
+    return false;
+  }
+  value = detail::scaleDown(magnitude, precision);
+  if (negative) {
+    value = -value;
+  }
+  return true;
+}
+
+/**
+ * @brief  valͽǡһʱȡż뵽precisionλСformatDecimal
+ *         дdstval * 10^precision2^53ʱfma˷ľȷ
+ *         ж뷽򣬲ֵַ˻snprintf
+ *         ȲNaNʱfalseҲдdst
+ */
+inline bool formatDouble(char *dst, size_t len, size_t precision, double val) {
+  if (!std::isfinite(val) || precision > 22) {
+    return false;
+  }
+
+  bool negative = std::signbit(val);
+  double magnitude = std::fabs(val);
+  double scale = detail::kPow10Double[precision];
+  double product = magnitude * scale;
+  if (product < static_cast<double>(detail::kMaxExactInt / 2)) {
+    double error = std::fma(magnitude, scale, -product);
+    double integer = std::floor(product);
+    double diff = product - integer - 0.5;
+    auto rounded = static_cast<int64_t>(integer);
+    if (diff > 0 || (diff == 0 && (error > 0 || (error == 0 && (rounded & 1))))) {
+      ++rounded;
+    }
+    return formatDecimal(dst, len, precision, negative ? -rounded : rounded);
+  }
+
+  char text[352];
+  int size = std::snprintf(text, sizeof text, "%.*f",
+                           static_cast<int>(precision), val);
+  if (size < 0 || static_cast<size_t>(size) > len) {
+    return false;
+  }
+  std::memset(dst, ' ', len - static_cast<size_t>(size));
+  std::memcpy(dst + len - static_cast<size_t>(size), text,
+              static_cast<size_t>(size));
+  return true;
+}
+
+// ڣȫո񣩶Ӧ
+const int32_t kNullDate = INT32_MIN;
+
+// ʱ䣨붼Ϊ0Ӧĺ
+const int64_t kNullDateTime = INT64_MIN;
+
+namespace detail {
+const int32_t kUnixJulianDay = 2440588; // 1970-01-01
+const int64_t kMillisPerDay = 86400000;
+} // namespace detail
+
+/**
+ * @brief  Visual FoxProTֶδպ͵int32
+ *         ת1970-01-01ĺȫ0kNullDateTime
+ */
+inline int64_t julianToMillis(int32_t day, int32_t millis) {
+  if (day == 0 && millis == 0) {
+    return kNullDateTime;
+  }
+  return (static_cast<int64_t>(day) - detail::kUnixJulianDay) *
+             detail::kMillisPerDay +
+         millis;
+}
+
+inline void millisToJulian(int64_t val, int32_t &day, int32_t &millis) {
+  if (val == kNullDateTime) {
+    day = millis = 0;
+    return;
+  }
+  int64_t days = val / detail::kMillisPerDay;
+  int64_t rest = val % detail::kMillisPerDay;
+  if (rest < 0) {
+    rest += detail::kMillisPerDay;
+    --days;
+  }
+  day = static_cast<int32_t>(days + detail::kUnixJulianDay);
+  millis = static_cast<int32_t>(rest);
+}
+
+// Lֶεȡֵ'?'ոΪδʼ
+enum class Logical : int8_t { kFalse = 0, kTrue = 1, kUnknown = -1 };
+
+namespace detail {
+// 8ֽǷȫASCIIֽ֣޹
+inline bool isEightDigits(uint64_t val) {
+  return (((val + 0x4646464646464646ULL) | (val - 0x3030303030303030ULL)) &
+          0x8080808080808080ULL) == 0;
+}
+
+inline bool isLeapYear(int32_t year) {
+  return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+inline unsigned daysInMonth(int32_t year, unsigned month) {
+  static const unsigned kDays[12] = {31, 28, 31, 30, 31, 30,
+                                     31, 31, 30, 31, 30, 31};
+  return month == 2 && isLeapYear(year) ? 29 : kDays[month - 1];
+}
+
+// 1970-01-01ת400ڼ㣬ѭ
+inline int32_t daysFromCivil(int32_t year, unsigned month, unsigned day) {
+  year -= month <= 2 ? 1 : 0;
+  int32_t era = (year >= 0 ? year : year - 399) / 400;
+  auto yoe = static_cast<unsigned>(year - era * 400);
+  unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+inline void civilFromDays(int32_t days, int32_t &year, unsigned &month,
+                          unsigned &day) {
+  days += 719468;
+  int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+  auto doe = static_cast<unsigned>(days - era * 146097);
+  unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  unsigned mp = (5 * doy + 2) / 153;
+  day = doy - (153 * mp + 2) / 5 + 1;
+  month = mp < 10 ? mp + 3 : mp - 9;
+  year = static_cast<int32_t>(yoe) + era * 400 + (month <= 2 ? 1 : 0);
+}
+} // namespace detail
+
+/**
+ * @brief  YYYYMMDDʽDֶΪ1970-01-018һУ顢
+ *         һSWARתȫո񷵻kNullDateֻڲʱfalse
+ */
+inline bool dateToDays(const char *data, size_t len, int32_t &days) {
+  days = kNullDate;
+  if (len != 8) {
+    return false;
+  }
+  uint64_t word = 0;
+  std::memcpy(&word, data, sizeof word);
+  if (word == 0x2020202020202020ULL) {
+    return true;
+  }
+  if (!detail::isEightDigits(word)) {
+    return false;
+  }
+  auto ymd = static_cast<uint32_t>(detail::parseDigits(data, 8));
+  auto year = static_cast<int32_t>(ymd / 10000);
+  unsigned month = ymd / 100 % 100;
+  unsigned day = ymd % 100;
+  if (month < 1 || month > 12 || day < 1 ||
+      day > detail::daysInMonth(year, month)) {
+    return false;
+  }
+  days = detail::daysFromCivil(year, month, day);
+  return true;
+}
+
+/**
+ * @brief  дYYYYMMDDkNullDateд8ո
+ *         ֶγȲ8ݳ0000~9999ʱfalseҲдdst
+ */
+inline bool formatDate(char *dst, size_t len, int32_t days) {
+  if (len != 8) {
+    return false;
+  }
+  if (days == kNullDate) {
+    std::memset(dst, ' ', len);
+    return true;
+  }
+  int32_t year = 0;
+  unsigned month = 0, day = 0;
+  detail::civilFromDays(days, year, month, day);
+  if (year < 0 || year > 9999) {
+    return false;
+  }
+  detail::writeDigits(dst + len,
+                      static_cast<uint64_t>(year) * 10000 + month * 100 + day,
+                      8);
+  return true;
+}
+
+/**
+ * @brief  LֶΣT/t/Y/yΪ棬F/f/N/nΪ٣'?'ոΪδʼ
+ *         ַfalse
+ */
+inline bool charToLogical(char ch, Logical &value) {
+  switch (ch) {
+  case 'T':
+  case 't':
+  case 'Y':
+  case 'y':
+    value = Logical::kTrue;
+    return true;
+  case 'F':
+  case 'f':
+  case 'N':
+  case 'n':
+    value = Logical::kFalse;
+    return true;
+  case '?':
+  case ' ':
+    value = Logical::kUnknown;
+    return true;
+  default:
+    value = Logical::kUnknown;
+    return false;
+  }
+}
+
+inline char logicalToChar(Logical value) {
+  return value == Logical::kTrue ? 'T'
+                                 : (value == Logical::kFalse ? 'F' : '?');
+}
+
+// ͷASCIIֽڣλΪ0ĸSSE2ÿж16ֽ
+inline size_t asciiPrefix(const char *data, size_t len) {
+  size_t index = 0;
+#if DBF_DECIMAL_SSE2
+  for (; index + 16 <= len; index += 16) {
+    auto mask = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + index))));
+    if (mask != 0) {
+      return index + detail::countTrailingZeros(mask);
+    }
+  }
+#endif
+  while (index != len && static_cast<unsigned char>(data[index]) < 0x80) {
+    ++index;
+  }
+  return index;
+}
+
+inline bool isAscii(const char *data, size_t len) {
+  return asciiPrefix(data, len) == len;
+}
+
 template <size_t MaxSize, size_t PrecisionSize, typename T>
 inline bool intToFloatStringView(T val, boost::string_view &view) {
   static int64_t pow10[10] = {1,      10,      100,      1000,      10000,
@@ -0,0 +1,366 @@
+#include <spdlog/spdlog.h>
+
+#include "dbf/DBFAsyncWriter.h"
+#include "dbf/DBFBuffer.hpp"
+#include "dbf/DBFFile.h"
+#include "dbf/DBFHead.h"
+#include "dbf/DBFRecord.h"
+
+namespace dbf {
+const size_t DBFAsyncWriter::kMaxPendingBytes;
+
+DBFAsyncWriter::Group::Group()
+    : appendBuf(new DBFBuffer), patchBuf(new DBFBuffer), appendRecords(0),
+      items(0) {}
+
+size_t DBFAsyncWriter::Group::bytes() const {
+  return appendBuf->readableBytes() + patchBuf->readableBytes();
+}
+
+void DBFAsyncWriter::Group::clear() {
+  appendBuf->retrieveAll();
+  patchBuf->retrieveAll();
+  patchPos.clear();
+  appendRecords = 0;
+  items = 0;
+}
+
+DBFAsyncWriter::Group::Mark DBFAsyncWriter::Group::mark() const {
+  return Mark{appendBuf->readableBytes(), patchBuf->readableBytes(),
+              patchPos.size(), appendRecords, items};
+}
+
+/**
+ * @brief  صmarkʱ״̬֮ӵȫ¼
+ */
+void DBFAsyncWriter::Group::rollback(const Mark &mark) {
+  appendBuf->unwrite(appendBuf->readableBytes() - mark.appendBytes);
+  patchBuf->unwrite(patchBuf->readableBytes() - mark.patchBytes);
+  patchPos.resize(mark.patchCount);
+  appendRecords = mark.appendRecords;
+  items = mark.items;
+}
+
+/**
+ * @brief  ̨д̣߳÷ֻѼ¼лУд̰߳д
+ *         ÿֻһļͷеļ¼
+ *
+ * @param policy ˢ̲ԣӲfsyncÿevery롢ÿдevery¼
+ * @param maxPendingBytes д߳дֽ֮͵ޣ
+ *        ÷ȴһӵlist֣ܳһlist
+ */
+DBFAsyncWriter::DBFAsyncWriter(DBFFile &file, FsyncPolicy policy, size_t every,
+                               size_t maxPendingBytes)
+    : file_(file), policy_(policy), every_(every),
+      maxPendingBytes_(maxPendingBytes), recordBytes_(0), tail_(0),
+      session_(false), writingBytes_(0), enqueued_(0), written_(0), stopping_(false),
+      failed_(false), unsynced_(0) {}
+
+DBFAsyncWriter::~DBFAsyncWriter() { stop(); }
+
+/**
+ * @brief  д̣߳writeHeadreadHead֮ã
+ *         д߳ڼ÷ӦֱӶдfile
+ */
+bool DBFAsyncWriter::start() {
+  if (running()) {
+    return true;
+  }
+  session_ = !file_.inSession();
+  if (session_ && !file_.openSession()) {
+    session_ = false;
+    return false;
+  }
+
+  recordBytes_ = static_cast<size_t>(file_.head()->recordBytes());
+  tail_ = file_.writerPos();
+  stopping_ = false;
+  failed_ = false;
+  unsynced_ = 0;
+  lastSync_ = std::chrono::steady_clock::now();
+  thread_ = std::thread(&DBFAsyncWriter::run, this);
+  return true;
+}
+
+/**
+ * @brief  дʣļ¼ֹͣд߳
+ */
+bool DBFAsyncWriter::stop() {
+  if (!running()) {
+    return true;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wakeup_.notify_one();
+  notFull_.notify_all();
+  thread_.join();
+
+  bool ret = good();
+  if (session_) {
+    session_ = false;
+    ret = file_.closeSession() && ret;
+  }
+  return ret;
+}
+
+/**
+ * @brief  ȴǰӵļ¼ȫд
+ */
+bool DBFAsyncWriter::flush() {
+  if (!running()) {
+    return good();
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  uint64_t target = enqueued_;
+  wakeup_.notify_one();
+  flushed_.wait(lock, [this, target] { return written_ >= target || failed_; });
+  return !failed_;
+}
+
+bool DBFAsyncWriter::appendWriten(const DBFRecord &record) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!waitWritable(lock)) {
+    return false;
+  }
+  enqueueAppend(record);
+  lock.unlock();
+  wakeup_.notify_one();
+  return true;
+}
+
+bool DBFAsyncWriter::appendWriten(const std::shared_ptr<DBFRecord> &record) {
+  return appendWriten(*record);
+}
+
+/**
+ * @brief  listҪôȫӣҪôĳл쳣ʱȫˣ
+ *         DBFFile::appendWriten(list)һ
+ */
+bool DBFAsyncWriter::appendWriten(
+    const std::list<std::shared_ptr<DBFRecord>> &records) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!waitWritable(lock)) {
+    return false;
+  }
+  auto mark = front_.mark();
+  size_t tail = tail_;
+  uint64_t enqueued = enqueued_;
+  try {
+    for (auto &record : records) {
+      enqueueAppend(*record);
+    }
+  } catch (...) {
+    front_.rollback(mark);
+    tail_ = tail;
+    enqueued_ = enqueued;
+    throw;
+  }
+  lock.unlock();
+  wakeup_.notify_one();
+  return true;
+}
+
+/**
+ * @brief  readPosΪ0ļ¼Ϊ׷ӲreadPosDBFFile::overWritenһ
+ */
+bool DBFAsyncWriter::overWriten(const DBFRecord &record) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!waitWritable(lock)) {
+    return false;
+  }
+  if (record.readPos() == 0) {
+    const_cast<DBFRecord &>(record).setReadPos(enqueueAppend(record));
+  } else {
+    enqueuePatch(record);
+  }
+  lock.unlock();
+  wakeup_.notify_one();
+  return true;
+}
+
+bool DBFAsyncWriter::overWriten(const std::shared_ptr<DBFRecord> &record) {
+  return overWriten(*record);
+}
+
+/**
+ * @brief  ĳл쳣ʱlistˣѻreadPosָΪ0
+ */
+bool DBFAsyncWriter::overWriten(
+    const std::list<std::shared_ptr<DBFRecord>> &records) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!waitWritable(lock)) {
+    return false;
+  }
+  auto mark = front_.mark();
+  size_t tail = tail_;
+  uint64_t enqueued = enqueued_;
+  std::vector<DBFRecord *> appended;
+  try {
+    for (auto &record : records) {
+      if (record->readPos() == 0) {
+        record->setReadPos(enqueueAppend(*record));
+        appended.push_back(record.get());
+      } else {
+        enqueuePatch(*record);
+      }
+    }
+  } catch (...) {
+    for (auto record : appended) {
+      record->setReadPos(0);
+    }
+    front_.rollback(mark);
+    tail_ = tail;
+    enqueued_ = enqueued;
+    throw;
+  }
+  lock.unlock();
+  wakeup_.notify_one();
+  return true;
+}
+
+bool DBFAsyncWriter::good() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return !failed_;
+}
+
+bool DBFAsyncWriter::waitWritable(std::unique_lock<std::mutex> &lock) {
+  if (!running()) {
+    SPDLOG_WARN("Async writer is not running : {}", file_.name());
+    return false;
+  }
+  notFull_.wait(lock, [this] {
+    return failed_ || stopping_ ||
+           front_.bytes() + writingBytes_ < maxPendingBytes_;
+  });
+  return !failed_ && !stopping_;
+}
+
+/**
+ * @brief  ʱļλãؼ¼дλáл쳣ʱ
+ *         дһֽ׳ֻļ¼
+ */
+size_t DBFAsyncWriter::enqueueAppend(const DBFRecord &record) {
+  auto &buf = *front_.appendBuf;
+  buf.serializeOrRollback([&record, &buf] { record.serializeTo(buf); });
+  size_t pos = tail_;
+  tail_ += recordBytes_;
+  ++front_.appendRecords;
+  ++front_.items;
+  ++enqueued_;
+  return pos;
+}
+
+void DBFAsyncWriter::enqueuePatch(const DBFRecord &record) {
+  auto &buf = *front_.patchBuf;
+  buf.serializeOrRollback([&record, &buf] { record.serializeTo(buf); });
+  front_.patchPos.push_back(record.readPos());
+  ++front_.items;
+  ++enqueued_;
+}
+
+void DBFAsyncWriter::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    auto ready = [this] { return stopping_ || !front_.empty(); };
+    if (policy_ == kFsyncInterval && every_ > 0) {
+      wakeup_.wait_for(lock, std::chrono::milliseconds(every_), ready);
+    } else {
+      wakeup_.wait(lock, ready);
+    }
+    if (front_.empty() && stopping_) {
+      break;
+    }
+
+    //front_ֽתback_䣬д֮Żѵ÷
+    std::swap(front_, back_);
+    writingBytes_ = back_.bytes();
+    bool failed = failed_;
+    lock.unlock();
+
+    bool ok = true;
+    size_t items = back_.items;
+    if (!failed && !back_.empty()) {
+      ok = writeGroup(back_);
+    }
+    back_.clear();
+    if (!failed && ok) {
+      ok = syncIfDue(items, false);
+    }
+
+    lock.lock();
+    writingBytes_ = 0;
+    if (!ok) {
+      failed_ = true;
+    }
+    notFull_.notify_all();
+    written_ += items;
+    flushed_.notify_all();
+  }
+
+  bool failed = failed_;
+  lock.unlock();
+  if (!failed && !syncIfDue(0, true)) {
+    lock.lock();
+    failed_ = true;
+    lock.unlock();
+  }
+  flushed_.notify_all();
+}
+
+/**
+ * @brief  ׷Ӳִļ־һддһμ¼
+ *         дļ¼˳дԭλ
+ */
+bool DBFAsyncWriter::writeGroup(Group &group) {
+  if (group.appendRecords > 0) {
+    auto &head = file_.head();
+    group.appendBuf->appendChar(kEndFileFlag);
+    if (!file_.write(group.appendBuf->peek(),
+                     static_cast<long>(file_.writerPos()),
+                     group.appendBuf->readableBytes())) {
+      return false;
+    }
+
+    auto appendRecords = static_cast<int32_t>(group.appendRecords);
+    head->setRecordNumber(head->recordNumber() + appendRecords);
+    if (!file_.writeRecordNumber()) {
+      head->setRecordNumber(head->recordNumber() - appendRecords);
+      return false;
+    }
+    file_.setWriterPos(file_.writerPos() + group.appendRecords * recordBytes_);
+  }
+
+  const char *data = group.patchBuf->peek();
+  for (auto pos : group.patchPos) {
+    if (!file_.write(data, static_cast<long>(pos), recordBytes_)) {
+      return false;
+    }
+    data += recordBytes_;
+  }
+  return true;
+}
+
+bool DBFAsyncWriter::syncIfDue(size_t records, bool force) {
+  unsynced_ += records;
+  if (policy_ == kFsyncNever || unsynced_ == 0) {
+    return true;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  bool due = force;
+  if (policy_ == kFsyncRecords) {
+    due = due || unsynced_ >= every_;
+  } else {
+    due = due || now - lastSync_ >= std::chrono::milliseconds(every_);
+  }
+  if (!due) {
+    return true;
+  }
+
+  unsynced_ = 0;
+  lastSync_ = now;
+  return file_.sync();
+}
+} // namespace dbf
@@ -0,0 +1,477 @@
+#include <cctype>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "dbf/DBFCodeGenerator.h"
+#include "dbf/DBFFile.h"
+
+namespace dbf {
+namespace {
+const char *const kKeywords[] = {
+    "alignas",  "alignof",  "and",      "asm",       "auto",     "bool",
+    "break",    "case",     "catch",    "char",      "class",    "const",
+    "continue", "default",  "delete",   "do",        "double",   "else",
+    "enum",     "explicit", "export",   "extern",    "false",    "float",
+    "for",      "friend",   "goto",     "if",        "inline",   "int",
+    "long",     "mutable",  "namespace", "new",      "not",      "operator",
+    "or",       "private",  "protected", "public",   "register", "return",
+    "short",    "signed",   "sizeof",   "static",    "struct",   "switch",
+    "template", "this",     "throw",    "true",      "try",      "typedef",
+    "typename", "union",    "unsigned", "using",     "virtual",  "void",
+    "volatile", "while",    "xor"};
+
+bool isKeyword(const std::string &name) {
+  for (auto keyword : kKeywords) {
+    if (name == keyword) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// LAST_PX -> lastPxǺϷʶʱؿմ
+std::string toCamelCase(const std::string &name) {
+  std::string result;
+  bool upper = false;
+  for (char ch : name) {
+    auto uch = static_cast<unsigned char>(ch);
+    if (ch == '_') {
+      upper = !result.empty();
+      continue;
+    }
+    if (!std::isalnum(uch) || uch >= 0x80) {
+      return std::string();
+    }
+    if (result.empty() && std::isdigit(uch)) {
+      return std::string();
+    }
+    result +=
+        static_cast<char>(upper ? std::toupper(uch) : std::tolower(uch));
+    upper = false;
+  }
+  return result;
+}
+
+std::string capitalize(std::string name) {
+  if (!name.empty()) {
+    name[0] =
+        static_cast<char>(std::toupper(static_cast<unsigned char>(name[0])));
+  }
+  return name;
+}
+
+// DBFHeadField -> D_B_F_HEAD_FIELDɴͷļһ
+std::string toGuardName(const std::string &name) {
+  std::string result;
+  for (size_t index = 0; index < name.size(); ++index) {
+    auto uch = static_cast<unsigned char>(name[index]);
+    if (index > 0 && std::isupper(uch)) {
+      result += '_';
+    }
+    result += static_cast<char>(std::toupper(uch));
+  }
+  return result;
+}
+
+bool isClassType(const DBFCodeGenerator::Member &member) {
+  return member.fieldType == 'C';
+}
+} // namespace
+
+DBFCodeGenerator::DBFCodeGenerator(const std::string &className,
+                                   const std::string &nameSpace)
+    : className_(className), nameSpace_(nameSpace), recordBytes_(0) {}
+
+bool DBFCodeGenerator::load(const DBFFile &file) {
+  return load(file.headFields());
+}
+
+bool DBFCodeGenerator::load(const std::vector<DBFHeadField> &fields) {
+  std::vector<Member> members;
+  std::set<std::string> names;
+  size_t offset = 1;
+  for (size_t index = 0; index < fields.size(); ++index) {
+    const auto &field = fields[index];
+    Member member;
+    member.fieldName = field.name();
+    member.fieldType =
+        field.filedType().empty() ? '\0' : field.filedType()[0];
+    member.offset = offset;
+    member.totalLen = field.totalLen();
+    member.precisionLen = field.precisionLen();
+    offset += member.totalLen;
+
+    switch (member.fieldType) {
+    case 'C':
+      member.type =
+          "dbf::FixedString<" + std::to_string(member.totalLen) + ">";
+      break;
+    case 'N':
+    case 'F':
+      if (member.precisionLen > 0) {
+        member.type = "double";
+      } else {
+        member.type = member.totalLen <= 9 ? "int32_t" : "int64_t";
+      }
+      break;
+    case 'D':
+    case 'I':
+      member.type = "int32_t";
+      break;
+    case 'L':
+      member.type = "util::Logical";
+      break;
+    case 'M':
+    case 'G':
+    case 'P':
+      //ͨúͼƬֶMֶһֻ
+      member.fieldType = 'M';
+      member.type = "uint32_t";
+      break;
+    case 'B':
+      member.type = "double";
+      break;
+    case 'Y':
+    case 'T':
+      member.type = "int64_t";
+      break;
+    default:
+      SPDLOG_WARN("Unsupported field type {} : {}", field.filedType(),
+                  field.name());
+      return false;
+    }
+
+    auto name = toCamelCase(member.fieldName);
+    if (name.empty()) {
+      name = "field" + std::to_string(index);
+    }
+    if (isKeyword(name)) {
+      name += "Field";
+    }
+    if (!names.insert(name).second) {
+      name += std::to_string(index);
+      names.insert(name);
+    }
+    member.accessorName = name;
+    member.memberName = name + "_";
+    members.push_back(member);
+  }
+  members_.swap(members);
+  recordBytes_ = offset;
+  return true;
+}
+
+std::string DBFCodeGenerator::guard(const std::string &suffix) const {
+  return toGuardName(nameSpace_) + "_" + toGuardName(className_ + suffix) +
+         "_H";
+}
+
+std::string DBFCodeGenerator::readCall(const Member &member) const {
+  auto len = std::to_string(member.totalLen);
+  auto precision = std::to_string(member.precisionLen);
+  switch (member.fieldType) {
+  case 'C':
+    return "buff.readFixedString<" + len + ">()";
+  case 'N':
+  case 'F':
+    if (member.type == "double") {
+      return "buff.readDouble<" + len + ", " + precision + ">()";
+    }
+    return member.type == "int32_t" ? "buff.readInt32<" + len + ">()"
+                                    : "buff.readInt64<" + len + ">()";
+  case 'D':
+    return "buff.readDate<" + len + ">()";
+  case 'L':
+    return "buff.readLogical<" + len + ">()";
+  case 'M':
+    return "buff.readMemoBlock<" + len + ">()";
+  case 'I':
+    return "buff.readBinaryInt32()";
+  case 'B':
+    return "buff.readBinaryDouble()";
+  case 'Y':
+    return "buff.readBinaryCurrency()";
+  default:
+    return "buff.readBinaryDateTime()";
+  }
+}
+
+std::string DBFCodeGenerator::appendCall(const Member &member) const {
+  auto len = std::to_string(member.totalLen);
+  auto precision = std::to_string(member.precisionLen);
+  auto &value = member.memberName;
+  switch (member.fieldType) {
+  case 'C':
+    return "buff.appendString<" + len + ">(" + value + ")";
+  case 'N':
+  case 'F':
+    if (member.type == "double") {
+      return "buff.appendDouble<" + len + ", " + precision + ">(" + value +
+             ")";
+    }
+    return "buff.appendInt<" + len + ">(" + value + ")";
+  case 'D':
+    return "buff.appendDate<" + len + ">(" + value + ")";
+  case 'L':
+    return "buff.appendLogical<" + len + ">(" + value + ")";
+  case 'M':
+    return "buff.appendMemoBlock<" + len + ">(" + value + ")";
+  case 'I':
+    return "buff.appendBinaryInt32(" + value + ")";
+  case 'B':
+    return "buff.appendBinaryDouble(" + value + ")";
+  case 'Y':
+    return "buff.appendBinaryCurrency(" + value + ")";
+  default:
+    return "buff.appendBinaryDateTime(" + value + ")";
+  }
+}
+
+std::string DBFCodeGenerator::valueExpr(const Member &member,
+                                        const std::string &obj) const {
+  auto expr = obj + "." + member.accessorName + "()";
+  return member.fieldType == 'L' ? "static_cast<int>(" + expr + ")" : expr;
+}
+
+std::string DBFCodeGenerator::header() const {
+  std::ostringstream os;
+  os << "#ifndef " << guard("") << "\n";
+  os << "#define " << guard("") << "\n\n";
+  os << "#include <cstddef>\n";
+  os << "#include <cstdint>\n";
+  os << "#include <string>\n";
+  os << "#include <vector>\n\n";
+  os << "#include <nlohmann/json.hpp>\n\n";
+  os << "#include \"dbf/DBFFixedString.hpp\"\n";
+  os << "#include \"dbf/DBFRecord.h\"\n\n";
+  os << "namespace " << nameSpace_ << " {\n";
+  os << "class " << className_ << " : public dbf::DBFRecord {\n";
+  os << "public:\n";
+  os << "  static const size_t kRecordBytes = " << recordBytes_ << ";\n\n";
+  os << "public:\n";
+  os << "  " << className_ << "();\n";
+  os << "  ~" << className_ << "();\n\n";
+  os << "public:\n";
+  os << "  virtual void parseFrom(dbf::DBFBuffer &) override;\n";
+  os << "  virtual void serializeTo(dbf::DBFBuffer &) const override;\n";
+  os << "  virtual void parseFromJson(const nlohmann::json &) override;\n";
+  os << "  virtual void serializeToJson(nlohmann::json &) const override;\n";
+  os << "  virtual std::string toString() const override;\n\n";
+  os << "public:\n";
+  os << "  bool decode(const char *record);\n";
+  os << "  bool encode(char *record) const;\n";
+  os << "  static size_t decodeBatch(const char *data, size_t bytes,\n";
+  os << "                            std::vector<" << className_
+     << "> &records);\n\n";
+  os << "public:\n";
+  for (size_t index = 0; index < members_.size(); ++index) {
+    const auto &member = members_[index];
+    auto param = isClassType(member) ? "const " + member.type + " &"
+                                     : member.type + " ";
+    auto result = isClassType(member) ? "const " + member.type + " &"
+                                      : member.type + " ";
+    if (index > 0) {
+      os << "\n";
+    }
+    os << "  void set" << capitalize(member.accessorName) << "(" << param
+       << "value) { " << member.memberName << " = value; }\n";
+    os << "  " << result << member.accessorName << "() const { return "
+       << member.memberName << "; }\n";
+  }
+  os << "\nprivate:\n";
+  for (const auto &member : members_) {
+    os << "  " << member.type << " " << member.memberName << ";\n";
+  }
+  os << "};\n";
+  os << "} // namespace " << nameSpace_ << "\n";
+  os << "#endif\n";
+  return os.str();
+}
+
+std::string DBFCodeGenerator::source() const {
+  std::ostringstream os;
+  os << "#include <fmt/core.h>\n\n";
+  os << "#include <dbf/DBFBuffer.hpp>\n";
+  os << "#include <dbf/DBFSchema.hpp>\n";
+  os << "#include <util/StringUtil.hpp>\n\n";
+  os << "#include \"" << className_ << ".h\"\n";
+  os << "#include \"" << className_ << "Formatter.h\"\n";
+  os << "#include \"" << className_ << "JsonSerializer.hpp\"\n\n";
+  os << "namespace " << nameSpace_ << " {\n";
+  os << className_ << "::" << className_ << "()";
+  bool first = true;
+  for (const auto &member : members_) {
+    if (isClassType(member)) {
+      continue;
+    }
+    auto init = member.fieldType == 'D'   ? "util::kNullDate"
+                : member.fieldType == 'L' ? "util::Logical::kUnknown"
+                                          : "0";
+    os << (first ? "\n    : " : ",\n      ") << member.memberName << "("
+       << init << ")";
+    first = false;
+  }
+  os << " {}\n\n";
+  os << className_ << "::~" << className_ << "() = default;\n\n";
+
+  os << "void " << className_ << "::parseFrom(dbf::DBFBuffer &buff) {\n";
+  os << "  DBFRecord::parseFrom(buff);\n";
+  for (const auto &member : members_) {
+    os << "  {\n";
+    os << "    auto value = " << readCall(member) << ";\n";
+    os << "    set" << capitalize(member.accessorName) << "(value);\n";
+    os << "  }\n";
+  }
+  os << "}\n\n";
+
+  os << "void " << className_
+     << "::serializeTo(dbf::DBFBuffer &buff) const {\n";
+  os << "  DBFRecord::serializeTo(buff);\n";
+  for (const auto &member : members_) {
+    os << "  " << appendCall(member) << ";\n";
+  }
+  os << "}\n\n";
+
+  os << "void " << className_
+     << "::parseFromJson(const nlohmann::json &j) { *this = j; }\n\n";
+  os << "void " << className_
+     << "::serializeToJson(nlohmann::json &j) const { j = *this; }\n\n";
+  os << "std::string " << className_
+     << "::toString() const { return fmt::format(\"{}\", *this); }\n\n";
+
+  os << "bool " << className_ << "::decode(const char *record) {\n";
+  os << "  if (record[0] != 0x20 && record[0] != 0x2A) {\n";
+  os << "    return false;\n";
+  os << "  }\n";
+  os << "  setRecordDelete(record[0]);\n";
+  os << "  bool ok = true;\n";
+  for (const auto &member : members_) {
+    os << "  ok &= dbf::DBFFieldCodec<'" << member.fieldType << "'>::decode<"
+       << member.totalLen << ", " << member.precisionLen << ">(record + "
+       << member.offset << ", " << member.memberName << ");\n";
+  }
+  os << "  return ok;\n";
+  os << "}\n\n";
+
+  os << "bool " << className_ << "::encode(char *record) const {\n";
+  os << "  record[0] = recordDelete() ? 0x2A : 0x20;\n";
+  os << "  bool ok = true;\n";
+  for (const auto &member : members_) {
+    os << "  ok &= dbf::DBFFieldCodec<'" << member.fieldType << "'>::encode<"
+       << member.totalLen << ", " << member.precisionLen << ">(record + "
+       << member.offset << ", " << member.memberName << ");\n";
+  }
+  os << "  return ok;\n";
+  os << "}\n\n";
+
+  os << "size_t " << className_
+     << "::decodeBatch(const char *data, size_t bytes,\n";
+  os << std::string(className_.size() + 21, ' ') << "std::vector<"
+     << className_ << "> &records) {\n";
+  os << "  size_t count = bytes / kRecordBytes;\n";
+  os << "  records.resize(count);\n";
+  os << "  for (size_t index = 0; index < count; ++index) {\n";
+  os << "    if (!records[index].decode(data + index * kRecordBytes)) {\n";
+  os << "      records.resize(index);\n";
+  os << "      return index;\n";
+  os << "    }\n";
+  os << "  }\n";
+  os << "  return count;\n";
+  os << "}\n";
+  os << "} // namespace " << nameSpace_ << "\n";
+  return os.str();
+}
+
+std::string DBFCodeGenerator::jsonSerializer() const {
+  auto type = nameSpace_ + "::" + className_;
+  std::ostringstream os;
+  os << "#ifndef " << guard("JsonSerializer") << "\n";
+  os << "#define " << guard("JsonSerializer") << "\n\n";
+  os << "#include <cstdint>\n";
+  os << "#include <exception>\n";
+  os << "#include <string>\n\n";
+  os << "#include <nlohmann/json.hpp>\n";
+  os << "#include <dbf/DBFFixedStringJsonSerializer.hpp>\n\n";
+  os << "#include \"" << className_ << ".h\"\n\n";
+  os << "namespace nlohmann {\n";
+  os << "template <> struct adl_serializer<" << type << "> {\n";
+  os << "  static void from_json(const json &j, " << type << " &msg) {\n";
+  for (const auto &member : members_) {
+    os << "    if (j.contains(\"" << member.fieldName << "\")) {\n";
+    os << "      msg.set" << capitalize(member.accessorName) << "(j[\""
+       << member.fieldName << "\"].get<" << member.type << ">());\n";
+    os << "    } else {\n";
+    os << "      throw std::invalid_argument(\"JSON does not contain "
+       << member.fieldName << " field\");\n";
+    os << "    }\n";
+  }
+  os << "  }\n\n";
+  os << "  static void to_json(json &j, const " << type << " &msg) {\n";
+  for (const auto &member : members_) {
+    os << "    j[\"" << member.fieldName << "\"] = msg." << member.accessorName
+       << "();\n";
+  }
+  os << "  }\n";
+  os << "};\n";
+  os << "} // namespace nlohmann\n\n";
+  os << "#endif\n";
+  return os.str();
+}
+
+std::string DBFCodeGenerator::formatter() const {
+  auto type = nameSpace_ + "::" + className_;
+  std::ostringstream os;
+  os << "#ifndef " << guard("Formatter") << "\n";
+  os << "#define " << guard("Formatter") << "\n\n";
+  os << "#include <fmt/format.h>\n";
+  os << "#include <fmt/ranges.h>\n";
+  os << "#include <dbf/DBFFixedStringFormatter.h>\n\n";
+  os << "#include \"" << className_ << ".h\"\n\n";
+  os << "namespace fmt {\n";
+  os << "template <> struct formatter<" << type
+     << "> : formatter<std::string> {\n";
+  os << "  template <typename FormatContext>\n";
+  os << "  auto format(const " << type << " &p, FormatContext &ctx) const\n";
+  os << "      -> decltype(ctx.out()) {\n";
+  os << "    return format_to(ctx.out(), \"";
+  for (const auto &member : members_) {
+    os << member.fieldName << " : {} ";
+  }
+  os << "\"";
+  for (const auto &member : members_) {
+    os << ",\n                     " << valueExpr(member, "p");
+  }
+  os << ");\n";
+  os << "  }\n";
+  os << "};\n";
+  os << "} // namespace fmt\n\n";
+  os << "#endif\n";
+  return os.str();
+}
+
+bool DBFCodeGenerator::writeFiles(const std::string &dir) const {
+  auto prefix = dir.empty() ? className_ : dir + "/" + className_;
+  std::pair<std::string, std::string> files[] = {
+      {prefix + ".h", header()},
+      {prefix + ".cpp", source()},
+      {prefix + "JsonSerializer.hpp", jsonSerializer()},
+      {prefix + "Formatter.h", formatter()}};
+  for (const auto &file : files) {
+    std::ofstream out(file.first, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+      SPDLOG_WARN("Open generated file failed : {}", file.first);
+      return false;
+    }
+    out << file.second;
+    if (!out) {
+      SPDLOG_WARN("Write generated file failed : {}", file.first);
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace dbf
@@ -0,0 +1,407 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <malloc.h>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <boost/endian/conversion.hpp>
+#include <spdlog/spdlog.h>
+
+#include "dbf/DBFBuffer.hpp"
+#include "dbf/DBFDirectWriter.h"
+#include "dbf/DBFFile.h"
+#include "dbf/DBFHead.h"
+#include "dbf/DBFRecord.h"
+
+namespace dbf {
+const size_t DBFDirectWriter::kAlignBytes;
+const size_t DBFDirectWriter::kBlockBytes;
+
+namespace {
+char *alignedAlloc(size_t len, size_t align) {
+#ifdef _WIN32
+  return static_cast<char *>(_aligned_malloc(len, align));
+#else
+  void *ptr = nullptr;
+  if (0 != posix_memalign(&ptr, align, len)) {
+    return nullptr;
+  }
+  return static_cast<char *>(ptr);
+#endif
+}
+
+void alignedFree(char *ptr) {
+#ifdef _WIN32
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+} // namespace
+
+/**
+ * @brief  һԴƹҳдļڶ
+ *         ļҳ档뻺ʹãһ̨дʱ
+ *         һ¼
+ *
+ * @param file ṩļֶζ壬ɺļͷдλ֮
+ * @param blockBytes ÿд̵ĿСȡkAlignBytesı
+ */
+#ifdef _WIN32
+DBFDirectWriter::DBFDirectWriter(DBFFile &file, size_t blockBytes)
+    : file_(file), blockBytes_(alignUp(blockBytes)), blocks_{nullptr, nullptr},
+      current_(0), used_(0), blockPos_(0), records_(0), buf_(new DBFBuffer),
+      direct_(false), failed_(false), handle_(nullptr) {}
+#else
+DBFDirectWriter::DBFDirectWriter(DBFFile &file, size_t blockBytes)
+    : file_(file), blockBytes_(alignUp(blockBytes)), blocks_{nullptr, nullptr},
+      current_(0), used_(0), blockPos_(0), records_(0), buf_(new DBFBuffer),
+      direct_(false), failed_(false), fd_(-1) {}
+#endif
+
+DBFDirectWriter::~DBFDirectWriter() {
+  commit();
+  alignedFree(blocks_[0]);
+  alignedFree(blocks_[1]);
+}
+
+/**
+ * @brief  ļļͷŽһ飬¼д0commitʱٻ
+ */
+bool DBFDirectWriter::open() {
+  if (isOpen()) {
+    return true;
+  }
+  for (auto &block : blocks_) {
+    if (block == nullptr) {
+      block = alignedAlloc(blockBytes_, kAlignBytes);
+    }
+    if (block == nullptr) {
+      SPDLOG_WARN("Alloc failure : {} bytes aligned to {}", blockBytes_,
+                  kAlignBytes);
+      return false;
+    }
+  }
+  if (!openFile()) {
+    return false;
+  }
+
+  current_ = 0;
+  used_ = 0;
+  blockPos_ = 0;
+  records_ = 0;
+  failed_ = false;
+
+  file_.head_->setRecordNumber(0);
+  buf_->retrieveAll();
+  file_.serializeHead(*buf_);
+  return append(buf_->peek(), buf_->readableBytes());
+}
+
+/**
+ * @brief  дһ飨뵽볤ȣļͷеļ¼
+ *         ٰļضϵʵʳ
+ */
+bool DBFDirectWriter::commit() {
+  if (!isOpen()) {
+    return true;
+  }
+
+  bool ret = !failed_;
+  if (ret) {
+    char endFlag = DBFFile::kEndFileFlag;
+    ret = append(&endFlag, sizeof endFlag);
+  }
+  size_t size = blockPos_ + used_;
+  if (ret && used_ > 0) {
+    size_t len = alignUp(used_);
+    std::memset(blocks_[current_] + used_, 0, len - used_);
+    ret = flushBlock(len);
+  }
+  ret = waitPending() && ret;
+  ret = ret && patchRecordNumber() && truncate(size);
+  ret = closeFile() && ret;
+  if (!ret) {
+    return false;
+  }
+
+  file_.readerPos_ = file_.head_->headerBytes();
+  file_.writerPos_ = size - 1;
+  return true;
+}
+
+bool DBFDirectWriter::appendWriten(const DBFRecord &record) {
+  if (!isOpen() || failed_) {
+    return false;
+  }
+  buf_->retrieveAll();
+  record.serializeTo(*buf_);
+  if (!append(buf_->peek(), buf_->readableBytes())) {
+    return false;
+  }
+  ++records_;
+  return true;
+}
+
+bool DBFDirectWriter::appendWriten(const std::shared_ptr<DBFRecord> &record) {
+  return appendWriten(*record);
+}
+
+bool DBFDirectWriter::appendWriten(
+    const std::list<std::shared_ptr<DBFRecord>> &records) {
+  if (!isOpen() || failed_) {
+    return false;
+  }
+  buf_->retrieveAll();
+  for (auto &record : records) {
+    record->serializeTo(*buf_);
+  }
+  if (!append(buf_->peek(), buf_->readableBytes())) {
+    return false;
+  }
+  records_ += records.size();
+  return true;
+}
+
+bool DBFDirectWriter::append(const char *data, size_t len) {
+  while (len > 0) {
+    size_t size = std::min(len, blockBytes_ - used_);
+    std::memcpy(blocks_[current_] + used_, data, size);
+    used_ += size;
+    data += size;
+    len -= size;
+    if (used_ == blockBytes_ && !flushBlock(blockBytes_)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief  һдѵǰ齻̨длһ
+ */
+bool DBFDirectWriter::flushBlock(size_t len) {
+  if (!waitPending()) {
+    return false;
+  }
+  const char *block = blocks_[current_];
+  size_t pos = blockPos_;
+  pending_ = std::async(std::launch::async, [this, block, len, pos] {
+    return writeAt(block, len, pos);
+  });
+  current_ ^= 1;
+  blockPos_ += len;
+  used_ = 0;
+  return true;
+}
+
+bool DBFDirectWriter::waitPending() {
+  if (pending_.valid() && !pending_.get()) {
+    failed_ = true;
+  }
+  return !failed_;
+}
+
+/**
+ * @brief  ƹҳʱֻܰдصһ޸ļ¼д
+ */
+bool DBFDirectWriter::patchRecordNumber() {
+  char *block = blocks_[0];
+  if (!readAt(block, kAlignBytes, 0)) {
+    return false;
+  }
+  int32_t recordNumber = static_cast<int32_t>(records_);
+  file_.head_->setRecordNumber(recordNumber);
+  recordNumber = boost::endian::native_to_little(recordNumber);
+  std::memcpy(block + DBFFile::kRecorNumIndex, &recordNumber,
+              sizeof recordNumber);
+  return writeAt(block, kAlignBytes, 0);
+}
+
+#ifdef _WIN32
+bool DBFDirectWriter::isOpen() const { return handle_ != nullptr; }
+
+bool DBFDirectWriter::openFile() {
+  HANDLE handle = CreateFileA(
+      file_.name().c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+      nullptr, CREATE_ALWAYS,
+      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH,
+      nullptr);
+  if (handle == INVALID_HANDLE_VALUE) {
+    SPDLOG_WARN("Open failure : {}, error : {}", file_.name(), GetLastError());
+    return false;
+  }
+  handle_ = handle;
+  direct_ = true;
+  return true;
+}
+
+bool DBFDirectWriter::closeFile() {
+  if (handle_ == nullptr) {
+    return true;
+  }
+  bool ret = CloseHandle(static_cast<HANDLE>(handle_)) != 0;
+  if (!ret) {
+    SPDLOG_WARN("Close failure : {}", GetLastError());
+  }
+  handle_ = nullptr;
+  return ret;
+}
+
+bool DBFDirectWriter::writeAt(const char *buf, size_t len, size_t pos) {
+  OVERLAPPED overlapped = {};
+  overlapped.Offset = static_cast<DWORD>(pos);
+  overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(pos) >> 32);
+  DWORD size = 0;
+  if (!WriteFile(static_cast<HANDLE>(handle_), buf, static_cast<DWORD>(len),
+                 &size, &overlapped) ||
+      size != len) {
+    SPDLOG_WARN("Write failure : {}", GetLastError());
+    return false;
+  }
+  return true;
+}
+
+bool DBFDirectWriter::readAt(char *buf, size_t len, size_t pos) {
+  OVERLAPPED overlapped = {};
+  overlapped.Offset = static_cast<DWORD>(pos);
+  overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(pos) >> 32);
+  DWORD size = 0;
+  if (!ReadFile(static_cast<HANDLE>(handle_), buf, static_cast<DWORD>(len),
+                &size, &overlapped) ||
+      size != len) {
+    SPDLOG_WARN("Read failure : {}", GetLastError());
+    return false;
+  }
+  return true;
+}
+
+bool DBFDirectWriter::truncate(size_t len) {
+  LARGE_INTEGER size;
+  size.QuadPart = static_cast<LONGLONG>(len);
+  if (!SetFilePointerEx(static_cast<HANDLE>(handle_), size, nullptr,
+                        FILE_BEGIN) ||
+      !SetEndOfFile(static_cast<HANDLE>(handle_))) {
+    SPDLOG_WARN("Truncate failure : {}", GetLastError());
+    return false;
+  }
+  return true;
+}
+#else
+bool DBFDirectWriter::isOpen() const { return fd_ != -1; }
+
+/**
+ * @brief  ļϵͳ֧O_DIRECTtmpfsʱ˻Ϊͨд
+ *         ÿддӦҳ
+ */
+bool DBFDirectWriter::openFile() {
+  int flags = O_RDWR | O_CREAT | O_TRUNC;
+  direct_ = false;
+#ifdef O_DIRECT
+  fd_ = ::open(file_.name().c_str(), flags | O_DIRECT, 0666);
+  direct_ = fd_ != -1;
+  if (fd_ == -1 && errno == EINVAL) {
+    SPDLOG_WARN("O_DIRECT not supported, fallback to buffered io : {}",
+                file_.name());
+  }
+#endif
+  if (fd_ == -1) {
+    fd_ = ::open(file_.name().c_str(), flags, 0666);
+  }
+  if (fd_ == -1) {
+    SPDLOG_WARN("Open failure : {}", strerror(errno));
+    return false;
+  }
+#ifdef F_NOCACHE
+  if (!direct_) {
+    direct_ = fcntl(fd_, F_NOCACHE, 1) != -1;
+  }
+#endif
+  return true;
+}
+
+bool DBFDirectWriter::closeFile() {
+  if (fd_ == -1) {
+    return true;
+  }
+  int result = ::close(fd_);
+  fd_ = -1;
+  if (-1 == result && errno != EINTR) {
+    SPDLOG_WARN("Close failure : {}", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool DBFDirectWriter::writeAt(const char *buf, size_t len, size_t pos) {
+  const char *data = buf;
+  size_t offset = pos;
+  size_t remain = len;
+  while (remain > 0) {
+    auto size = ::pwrite(fd_, data, remain, static_cast<off_t>(offset));
+    if (-1 == size) {
+      if (errno == EINTR) {
+        continue;
+      }
+      SPDLOG_WARN("Write failure : {}", strerror(errno));
+      return false;
+    }
+    data += size;
+    remain -= static_cast<size_t>(size);
+    offset += static_cast<size_t>(size);
+  }
+
+  if (!direct_) {
+#ifdef SYNC_FILE_RANGE_WRITE
+    sync_file_range(fd_, static_cast<off_t>(pos), static_cast<off_t>(len),
+                    SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE |
+                        SYNC_FILE_RANGE_WAIT_AFTER);
+#endif
+#ifdef POSIX_FADV_DONTNEED
+    posix_fadvise(fd_, static_cast<off_t>(pos), static_cast<off_t>(len),
+                  POSIX_FADV_DONTNEED);
+#endif
+  }
+  return true;
+}
+
+bool DBFDirectWriter::readAt(char *buf, size_t len, size_t pos) {
+  while (len > 0) {
+    auto size = ::pread(fd_, buf, len, static_cast<off_t>(pos));
+    if (-1 == size) {
+      if (errno == EINTR) {
+        continue;
+      }
+      SPDLOG_WARN("Read failure : {}", strerror(errno));
+      return false;
+    }
+    if (0 == size) {
+      SPDLOG_WARN("Read failure : unexpected end of file, pos : {}", pos);
+      return false;
+    }
+    buf += size;
+    len -= static_cast<size_t>(size);
+    pos += static_cast<size_t>(size);
+  }
+  return true;
+}
+
+bool DBFDirectWriter::truncate(size_t len) {
+  if (0 != ::ftruncate(fd_, static_cast<off_t>(len))) {
+    SPDLOG_WARN("Truncate failure : {}", strerror(errno));
+    return false;
+  }
+  return true;
+}
+#endif
+} // namespace dbf
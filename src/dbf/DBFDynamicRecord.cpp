@@ -0,0 +1,99 @@
+#include <cstring>
+
+#include "dbf/DBFDynamicRecord.h"
+
+namespace dbf {
+DBFDynamicRecord::DBFDynamicRecord(const DBFTable &table,
+                                   const allocator_type &alloc)
+    : table_(&table), bytes_(table.recordBytes(), ' ', alloc) {}
+
+DBFDynamicRecord::DBFDynamicRecord(const DBFDynamicRecord &other,
+                                   const allocator_type &alloc)
+    : DBFRecord(other), table_(other.table_), bytes_(other.bytes_, alloc) {}
+
+void DBFDynamicRecord::parseFrom(DBFBuffer &buf) {
+  size_t recordBytes = table_->recordBytes();
+  if (buf.readableBytes() < recordBytes) {
+    buf.fail(DBFStatus::kInsufficientData, "Read dynamic record failed");
+    return;
+  }
+  DBFRecord::parseFrom(buf);
+  if (buf.status() != DBFStatus::kOk) {
+    return;
+  }
+  bytes_.resize(recordBytes);
+  bytes_[0] = recordDelete() ? 0x2A : 0x20;
+  std::memcpy(bytes_.data() + 1, buf.peek(), recordBytes - 1);
+  buf.retrieve(recordBytes - 1);
+}
+
+void DBFDynamicRecord::serializeTo(DBFBuffer &buf) const {
+  DBFRecord::serializeTo(buf);
+  size_t len = bytes_.size() - 1;
+  buf.ensureWritableBytes(len);
+  std::memcpy(buf.beginWrite(), bytes_.data() + 1, len);
+  buf.hasWritten(len);
+}
+
+std::string DBFDynamicRecord::toString() const {
+  std::string str;
+  for (size_t index = 0; index < table_->fieldCount(); ++index) {
+    auto value = stringView(index);
+    str += table_->field(index).name();
+    str += " : ";
+    str.append(value.data(), value.size());
+    str += ' ';
+  }
+  return str;
+}
+
+void DBFDynamicRecord::assign(const char *data) {
+  bytes_.assign(data, data + table_->recordBytes());
+  setRecordDelete(data[0]);
+}
+
+int64_t DBFDynamicRecord::readInt64(size_t index) const {
+  auto record = view();
+  switch (table_->kind(index)) {
+  case DBFTable::kString:
+  case DBFTable::kInteger:
+  case DBFTable::kDecimal:
+    //СλʱطŴ10^precisionĶֵDBFBuffer::readIntһ
+    return record.readInt<int64_t>(index);
+  case DBFTable::kDate:
+    return record.readDate(index);
+  case DBFTable::kLogical:
+    return record.readLogical(index) == util::Logical::kTrue ? 1 : 0;
+  case DBFTable::kMemo:
+    return record.readMemoBlock(index);
+  case DBFTable::kBinaryInt:
+    return record.readBinaryInt32(index);
+  case DBFTable::kBinaryDouble:
+    return static_cast<int64_t>(record.readBinaryDouble(index));
+  case DBFTable::kCurrency:
+    return record.readBinaryCurrency(index);
+  case DBFTable::kDateTime:
+    return record.readBinaryDateTime(index);
+  default:
+    throw std::invalid_argument("Unsupported field type : " +
+                                table_->field(index).filedType());
+  }
+}
+
+double DBFDynamicRecord::readDouble(size_t index) const {
+  auto record = view();
+  switch (table_->kind(index)) {
+  case DBFTable::kString:
+  case DBFTable::kInteger:
+  case DBFTable::kDecimal:
+    return record.readDouble(index);
+  case DBFTable::kBinaryDouble:
+    return record.readBinaryDouble(index);
+  case DBFTable::kCurrency:
+    //ֶǷŴ10000
+    return static_cast<double>(record.readBinaryCurrency(index)) / 10000;
+  default:
+    return static_cast<double>(readInt64(index));
+  }
+}
+} // namespace dbf
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <exception>
@@ -22,14 +23,68 @@
 #include "dbf/DBFBuffer.hpp"
 #include "dbf/DBFFile.h"
 #include "dbf/DBFHead.h"
+#include "dbf/DBFLiveBitmap.h"
 #include "dbf/DBFRecord.h"
+#include "dbf/DBFStorage.h"
 
 namespace dbf {
+namespace {
+class ScopedSession {
+public:
+  explicit ScopedSession(DBFFile &file) : file_(file), opened_(false) {}
+  ~ScopedSession() {
+    if (opened_) {
+      file_.closeSession();
+    }
+  }
+
+  bool open() {
+    if (file_.inSession()) {
+      return true;
+    }
+    opened_ = file_.openSession();
+    return opened_;
+  }
+
+private:
+  DBFFile &file_;
+  bool opened_;
+};
+
+// Visual FoxProֶεĹ̶ȣͷ0
+uint8_t binaryFieldLen(const std::string &type) {
+  if (type == "I") {
+    return 4;
+  }
+  if (type == "B" || type == "Y" || type == "T") {
+    return 8;
+  }
+  return 0;
+}
+} // namespace
+
 DBFFile::DBFFile(const std::string &name)
     : name_(name), file_(nullptr), writerPos_(0), readerPos_(0),
-      head_(new DBFHead), buf_(new DBFBuffer) {}
+      head_(new DBFHead), buf_(new DBFBuffer), attached_(false),
+      syncPolicy_(kSyncNone), format_(kDbase3), decodeMode_(kDecodeThrow), bulkBytes_(0), bulkPos_(0),
+      bulkSession_(false), bulkFailed_(false) {}
 
-DBFFile::~DBFFile() {}
+/**
+ * @brief  ڵ÷ṩֽԴ/Ŀ϶дڴеdbfݻ򲻿ɻ˵
+ */
+DBFFile::DBFFile(std::unique_ptr<DBFStorage> storage)
+    : file_(nullptr), writerPos_(0), readerPos_(0), head_(new DBFHead),
+      buf_(new DBFBuffer), storage_(std::move(storage)), attached_(true),
+      syncPolicy_(kSyncNone), format_(kDbase3), decodeMode_(kDecodeThrow), bulkBytes_(0), bulkPos_(0),
+      bulkSession_(false), bulkFailed_(false) {}
+
+DBFFile::~DBFFile() {
+  if (inBulkLoad()) {
+    commitBulkLoad();
+  }
+  attached_ = false;
+  closeStorage();
+}
 
 void DBFFile::appendHeadField(const std::string &name, const std::string &type,
                               uint8_t totalLen, uint8_t precisionLen) {
@@ -40,6 +95,23 @@ void DBFFile::appendHeadField(const std::string &name, const std::string &type,
     SPDLOG_WARN("Field desc error type : D, total len  {}", totalLen);
     totalLen = 8;
   }
+  if (type == "L" && totalLen != 1) {
+    SPDLOG_WARN("Field desc error type : L, total len  {}", totalLen);
+    totalLen = 1;
+  }
+  if (type == "M" && totalLen != 10 && totalLen != 4) {
+    SPDLOG_WARN("Field desc error type : M, total len  {}", totalLen);
+    totalLen = format_ == kVisualFoxPro ? 4 : 10;
+  }
+  uint8_t binaryLen = binaryFieldLen(type);
+  if (binaryLen != 0) {
+    if (totalLen != binaryLen) {
+      SPDLOG_WARN("Field desc error type : {}, total len  {}", type,
+                  totalLen);
+      totalLen = binaryLen;
+    }
+    format_ = kVisualFoxPro; //ֶֻVisual FoxProʽ֧
+  }
   headFields_.back().setTotalLen(totalLen);
   headFields_.back().setPrecisionLen(precisionLen);
 }
@@ -82,9 +154,13 @@ bool DBFFile::readHead() {
     return false;
   }
 
+  //Visual FoxProֶ֮backlinkֶθԽ־Ϊ׼
   size_t recordNum = (recordLen - 1) / kFieldLen;
   int16_t recordBytes = 1;
-  for (size_t index = 0; index < recordNum; ++index) {
+  std::vector<DBFHeadField> headFields;
+  headFields.reserve(recordNum);
+  for (size_t index = 0; index < recordNum && *buf_->peek() != kEndHeadFlag;
+       ++index) {
     DBFHeadField field;
     field.setReadPos(readerPos_);
     try {
@@ -93,8 +169,10 @@ bool DBFFile::readHead() {
       SPDLOG_WARN("The field descriptor of the DBF file is parsed incorrectly : {}", ex.what());
       return false;
     }
-    checkHeadField(headFields_[index], field);
-    headFields_.push_back(field);
+    if (index < headFields_.size()) {
+      checkHeadField(headFields_[index], field);
+    }
+    headFields.push_back(field);
     recordBytes += field.totalLen();
     readerPos_ += kFieldLen;
   }
@@ -115,18 +193,44 @@ bool DBFFile::readHead() {
     SPDLOG_WARN("File header termination identifier error : {}", endChar);
     return false;
   }
-  readerPos_ += 1;
+  format_ = (head_->version() & 0xF0) == kVisualFoxPro ? kVisualFoxPro
+                                                        : kDbase3;
+  readerPos_ = static_cast<size_t>(head_->headerBytes());
   writerPos_ = readerPos_ + static_cast<size_t>(head_->recordNumber()) *
                                 static_cast<size_t>(head_->recordBytes());
+  headFields_.swap(headFields);
+  layout_.reset(headFields_);
   return true;
 }
 
 bool DBFFile::writeHead() {
-  uint16_t headBytes =
-      static_cast<uint16_t>(kFieldLen * (headFields_.size() + 1) + 1);
-  head_->setHeaderBytes(headBytes);
+  buf_->retrieveAll();
+  serializeHead(*buf_);
+  buf_->appendChar(kEndFileFlag); //дļ־
+  readerPos_ = buf_->readableBytes() - 1;
+  writerPos_ = readerPos_;
+  return appendWriten(*buf_) && syncBatch();
+}
+
+/**
+ * @brief  ǰֶζļͷлļͷ־
+ */
+void DBFFile::serializeHead(DBFBuffer &buf) {
+  size_t headBytes = kFieldLen * (headFields_.size() + 1) + 1;
+  if (format_ == kVisualFoxPro) {
+    headBytes += kBacklinkBytes;
+  }
+  head_->setHeaderBytes(static_cast<int16_t>(headBytes));
   head_->setReadPos(0);
-  head_->setVersion(3);
+  head_->setVersion(static_cast<int8_t>(format_));
+  bool hasMemo = std::any_of(
+      headFields_.begin(), headFields_.end(),
+      [](const DBFHeadField &field) { return field.filedType() == "M"; });
+  if (hasMemo && format_ == kVisualFoxPro) {
+    head_->setMdxTag(static_cast<int8_t>(head_->mdxTag() | kFptFlag));
+  } else if (hasMemo) {
+    head_->setVersion(kDbtVersion);
+  }
 
   std::time_t currentTime = std::time(nullptr);
   std::tm *localTime = std::localtime(&currentTime);
@@ -136,20 +240,25 @@ bool DBFFile::writeHead() {
 
   int16_t recordBytes = 1; //һֽڱǼ¼Ƿɾ
   for (auto &headField : headFields_) {
+    if (format_ == kVisualFoxPro) {
+      headField.setReservedBytes1(recordBytes); //ֶڼ¼еƫ
+    }
     recordBytes += headField.totalLen();
   }
   head_->setRecordBytes(recordBytes);
 
-  buf_->retrieveAll();
-  head_->serializeTo(*buf_);
+  layout_.reset(headFields_);
+
+  head_->serializeTo(buf);
   for (auto &headField : headFields_) {
-    headField.serializeTo(*buf_);
+    headField.serializeTo(buf);
+  }
+  buf.appendChar(kEndHeadFlag); //дļͷ־
+  if (format_ == kVisualFoxPro) {
+    buf.ensureWritableBytes(kBacklinkBytes);
+    std::memset(buf.beginWrite(), 0, kBacklinkBytes);
+    buf.hasWritten(kBacklinkBytes);
   }
-  buf_->appendChar(kEndHeadFlag); //дļͷ־
-  buf_->appendChar(kEndFileFlag); //дļ־
-  readerPos_ = buf_->readableBytes() - 1;
-  writerPos_ = readerPos_;
-  return appendWriten(*buf_);
 }
 
 bool DBFFile::read(DBFRecord &record) {
@@ -163,10 +272,7 @@ bool DBFFile::read(DBFRecord &record) {
   }
 
   record.setReadPos(readerPos_);
-  try {
-    record.parseFrom(*buf_);
-  } catch (const std::exception &ex) {
-    SPDLOG_WARN("Record parse failed : {}", ex.what());
+  if (!parseRecord(record, *buf_, readerPos_)) {
     return false;
   }
   readerPos_ += recordBytes;
@@ -178,22 +284,14 @@ bool DBFFile::read(const std::shared_ptr<DBFRecord> &record) {
 }
 
 bool DBFFile::read(const std::list<std::shared_ptr<DBFRecord>> &records) {
-  size_t allSize = head_->recordBytes() * records.size();
-  buf_->retrieveAll();
-  buf_->ensureWritableBytes(allSize);
-  buf_->hasWritten(allSize);
-
-  if (!read(*buf_)) {
+  if (!fillRecords(readerPos_, records.size())) {
     return false;
   }
 
   auto pos = readerPos_;
   for (auto &record : records) {
     record->setReadPos(pos);
-    try {
-      record->parseFrom(*buf_);
-    } catch (const std::exception &ex) {
-      SPDLOG_WARN("Record parse failed : {}", ex.what());
+    if (!parseRecord(*record, *buf_, pos)) {
       return false;
     }
     pos += head_->recordBytes();
@@ -213,10 +311,7 @@ bool DBFFile::overRead(DBFRecord &record) {
     return false;
   }
 
-  try {
-    record.parseFrom(*buf_);
-  } catch (const std::exception &ex) {
-    SPDLOG_WARN("Record parse failed : {}", ex.what());
+  if (!parseRecord(record, *buf_, pos)) {
     return false;
   }
   record.setReadPos(pos);
@@ -232,24 +327,16 @@ bool DBFFile::overRead(const std::list<std::shared_ptr<DBFRecord>> &records) {
     return true;
   }
 
-  size_t allSize = head_->recordBytes() * records.size();
-  buf_->retrieveAll();
-  buf_->ensureWritableBytes(allSize);
-  buf_->hasWritten(allSize);
-
   auto pos = (*records.begin())->readPos();
   if (0 == pos) {
     pos = readerPos_;
   }
-  if (!read(buf_->peek(), static_cast<long>(pos), allSize)) {
+  if (!fillRecords(pos, records.size())) {
     return false;
   }
 
   for (auto &record : records) {
-    try {
-      record->parseFrom(*buf_);
-    } catch (const std::exception &ex) {
-      SPDLOG_WARN("Record parse failed : {}", ex.what());
+    if (!parseRecord(*record, *buf_, pos)) {
       return false;
     }
     record->setReadPos(pos);
@@ -262,7 +349,97 @@ bool DBFFile::overRead(const std::list<std::shared_ptr<DBFRecord>> &records) {
   return true;
 }
 
+bool DBFFile::read(DBFRecordView &view) {
+  if (!viewAt(view, readerPos_)) {
+    return false;
+  }
+  readerPos_ += head_->recordBytes();
+  return true;
+}
+
+bool DBFFile::overRead(DBFRecordView &view) {
+  return viewAt(view, view.readPos() == 0 ? readerPos_ : view.readPos());
+}
+
+/**
+ * @brief  kDecodeThrow²쳣־kDecodeStatus²쳣Ҳ־
+ *         ʽparseFrom׳쳣ֻdiagnostics_ü¼ʣֽ
+ */
+bool DBFFile::parseRecord(DBFRecord &record, DBFBuffer &buf, size_t pos) {
+  if (decodeMode_ == kDecodeThrow) {
+    try {
+      record.parseFrom(buf);
+    } catch (const std::exception &ex) {
+      return parseFailed(ex);
+    }
+    return true;
+  }
+
+  return decodeStatus(buf, pos, [&record, &buf] { record.parseFrom(buf); });
+}
+
+bool DBFFile::parseFailed(const std::exception &ex) {
+  SPDLOG_WARN("Record parse failed : {}", ex.what());
+  return false;
+}
+
+/**
+ * @brief  ½ʧܵļ¼ʣֽڣǷfalse
+ */
+bool DBFFile::skipRecord(DBFBuffer &buf, size_t pos, size_t before) {
+  diagnostics_.record(buf.status(), pos, before - buf.errorReadable());
+  size_t consumed = before - buf.readableBytes();
+  auto recordBytes = static_cast<size_t>(head_->recordBytes());
+  if (consumed < recordBytes) {
+    buf.retrieve(std::min(recordBytes - consumed, buf.readableBytes()));
+  }
+  buf.clearStatus();
+  return false;
+}
+
+/**
+ * @brief  ӳģʽͼֱָӳָbuf_´ζдǰЧ
+ */
+bool DBFFile::viewAt(DBFRecordView &view, size_t pos) {
+  size_t recordBytes = head_->recordBytes();
+  const char *data = nullptr;
+  if (isMapped()) {
+    data = storage_->data(pos, recordBytes);
+    if (data == nullptr) {
+      return false;
+    }
+  } else {
+    buf_->retrieveAll();
+    buf_->ensureWritableBytes(recordBytes);
+    buf_->hasWritten(recordBytes);
+    if (!read(buf_->peek(), static_cast<long>(pos), recordBytes)) {
+      return false;
+    }
+    data = buf_->peek();
+  }
+  view = DBFRecordView(data, &layout_, pos);
+  return true;
+}
+
+/**
+ * @brief  poscount¼buf_
+ */
+bool DBFFile::fillRecords(size_t pos, size_t count) {
+  size_t allSize = recordBytes() * count;
+  buf_->retrieveAll();
+  buf_->ensureWritableBytes(allSize);
+  buf_->hasWritten(allSize);
+  return read(buf_->peek(), static_cast<long>(pos), allSize);
+}
+
+size_t DBFFile::recordBytes() const {
+  return static_cast<size_t>(head_->recordBytes());
+}
+
 bool DBFFile::overWriten(const DBFRecord &record) {
+  if (!checkRecordWritable()) {
+    return false;
+  }
   buf_->retrieveAll();
   record.serializeTo(*buf_);
   size_t pos = record.readPos();
@@ -284,68 +461,121 @@ bool DBFFile::overWriten(const DBFRecord &record) {
     const_cast<DBFRecord &>(record).setReadPos(pos);
     writerPos_ += head_->recordBytes();
   }
-  return true;
+  return syncBatch();
 }
 
 bool DBFFile::overWriten(const std::shared_ptr<DBFRecord> &record) {
   return overWriten(*record);
 }
 
+/**
+ * @brief  д¼Ҫ򣺰readPosڼ¼ϲɶΣ
+ *         ֻһļreadPosΪ0ļ¼׷ӵļβ
+ */
 bool DBFFile::overWriten(const std::list<std::shared_ptr<DBFRecord>> &records) {
-  if (records.empty()) {
-    return true;
+  if (!checkRecordWritable()) {
+    return false;
   }
-  buf_->retrieveAll();
+  batch_.clear();
   for (auto &record : records) {
-    record->serializeTo(*buf_);
+    batch_.push_back(record.get());
   }
-  size_t pos = (*records.begin())->readPos();
-  if (0 == pos) {
-    buf_->appendChar(kEndFileFlag);
-    pos = writerPos_;
+  return overWritenBatch();
+}
+
+bool DBFFile::overWritenBatch() {
+  if (batch_.empty()) {
+    return true;
   }
 
-  if (!write(buf_->peek(), static_cast<long>(pos), buf_->readableBytes())) {
+  ScopedSession session(*this);
+  if (!session.open()) {
     return false;
   }
 
-  int32_t newRecordNum = 0;
-  if (pos + buf_->readableBytes() - 1 > writerPos_) {
-    newRecordNum =
-        (pos + buf_->readableBytes() - 1 - writerPos_) / head_->recordBytes();
+  size_t recordBytes = static_cast<size_t>(head_->recordBytes());
+  scatter_.clear();
+  for (auto record : batch_) {
+    if (record->readPos() != 0) {
+      scatter_.push_back(record);
+    }
   }
+  std::stable_sort(scatter_.begin(), scatter_.end(),
+                   [](const DBFRecord *lhs, const DBFRecord *rhs) {
+                     return lhs->readPos() < rhs->readPos();
+                   });
 
-  if (newRecordNum > 0) {
-    head_->setRecordNumber(head_->recordNumber() + newRecordNum);
-    if (!writeRecordNumber()) {
-      head_->setRecordNumber(head_->recordNumber() - newRecordNum);
-      return false;
+  buf_->retrieveAll();
+  for (auto record : scatter_) {
+    record->serializeTo(*buf_);
+  }
+
+  size_t offset = 0;
+  for (size_t begin = 0; begin < scatter_.size();) {
+    size_t end = begin + 1;
+    while (end < scatter_.size() &&
+           scatter_[end]->readPos() ==
+               scatter_[end - 1]->readPos() + recordBytes) {
+      ++end;
     }
-    for (auto &record : records) {
-      record->setReadPos(pos);
-      pos += head_->recordBytes();
+    size_t len = (end - begin) * recordBytes;
+    if (!write(buf_->peek() + offset,
+               static_cast<long>(scatter_[begin]->readPos()), len)) {
+      return false;
     }
-    writerPos_ = pos;
+    offset += len;
+    begin = end;
+  }
+
+  //дļβĲΪ¼
+  size_t writerPos = writerPos_;
+  if (!scatter_.empty() &&
+      scatter_.back()->readPos() + recordBytes > writerPos) {
+    writerPos = scatter_.back()->readPos() + recordBytes;
   }
-  return true;
-}
 
-bool DBFFile::appendWriten(const DBFRecord &record) {
   buf_->retrieveAll();
-  record.serializeTo(*buf_);
+  for (auto record : batch_) {
+    if (record->readPos() == 0) {
+      record->serializeTo(*buf_);
+    }
+  }
+  if (writerPos == writerPos_ && buf_->readableBytes() == 0) {
+    return syncBatch();
+  }
   buf_->appendChar(kEndFileFlag);
-
-  if (!appendRecordWriten(*buf_)) {
+  if (!write(buf_->peek(), static_cast<long>(writerPos),
+             buf_->readableBytes())) {
     return false;
   }
 
-  head_->setRecordNumber(head_->recordNumber() + 1);
+  writerPos += buf_->readableBytes() - 1;
+  int32_t newRecordNum =
+      static_cast<int32_t>((writerPos - writerPos_) / recordBytes);
+  head_->setRecordNumber(head_->recordNumber() + newRecordNum);
   if (!writeRecordNumber()) {
-    head_->setRecordNumber(head_->recordNumber() - 1);
+    head_->setRecordNumber(head_->recordNumber() - newRecordNum);
     return false;
   }
-  writerPos_ += head_->recordBytes();
-  return true;
+
+  size_t pos = writerPos - (buf_->readableBytes() - 1);
+  for (auto record : batch_) {
+    if (record->readPos() == 0) {
+      record->setReadPos(pos);
+      pos += recordBytes;
+    }
+  }
+  writerPos_ = writerPos;
+  return syncBatch();
+}
+
+bool DBFFile::appendWriten(const DBFRecord &record) {
+  if (!checkRecordWritable()) {
+    return false;
+  }
+  auto &buf = beginAppend();
+  buf.serializeOrRollback([&record, &buf] { record.serializeTo(buf); });
+  return commitAppend(1);
 }
 
 bool DBFFile::appendWriten(const std::shared_ptr<DBFRecord> &record) {
@@ -354,26 +584,72 @@ bool DBFFile::appendWriten(const std::shared_ptr<DBFRecord> &record) {
 
 bool DBFFile::appendWriten(
     const std::list<std::shared_ptr<DBFRecord>> &records) {
+  if (!checkRecordWritable()) {
+    return false;
+  }
+  auto &buf = beginAppend();
+  buf.serializeOrRollback([&records, &buf] {
+    for (auto &record : records) {
+      record->serializeTo(buf);
+    }
+  });
+  return commitAppend(records.size());
+}
+
+/**
+ * @brief  ׷ӡǼ¼Ҫдļͷеļ¼ɻ˵
+ *         װ;дʧֱܺcommitBulkLoadٽܼ¼
+ */
+bool DBFFile::checkRecordWritable() const {
+  if (storage_ && !storage_->seekable()) {
+    SPDLOG_WARN("Write record failure : storage is not seekable, "
+                "only writeHead is supported");
+    return false;
+  }
+  if (bulkFailed_) {
+    SPDLOG_WARN("Write record failure : bulk load flush failed, "
+                "commitBulkLoad to finish");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief  ׷ʱ¼лĻװڼΪbulkBuf_Ϊյbuf_
+ */
+DBFBuffer &DBFFile::beginAppend() {
+  if (inBulkLoad()) {
+    return *bulkBuf_;
+  }
   buf_->retrieveAll();
-  for (auto &record : records) {
-    record->serializeTo(*buf_);
+  return *buf_;
+}
+
+/**
+ * @brief  beginAppend֮лcount¼дļ¼¼
+ */
+bool DBFFile::commitAppend(size_t count) {
+  if (inBulkLoad()) {
+    head_->setRecordNumber(head_->recordNumber() + static_cast<int32_t>(count));
+    writerPos_ += head_->recordBytes() * count;
+    return bulkBuf_->readableBytes() < bulkBytes_ || flushBulk();
   }
+
   buf_->appendChar(kEndFileFlag);
 
   if (!appendRecordWriten(*buf_)) {
     return false;
   }
 
-  head_->setRecordNumber(head_->recordNumber() +
-                         static_cast<int32_t>(records.size()));
+  head_->setRecordNumber(head_->recordNumber() + static_cast<int32_t>(count));
   if (!writeRecordNumber()) {
     head_->setRecordNumber(head_->recordNumber() -
-                           static_cast<int32_t>(records.size()));
+                           static_cast<int32_t>(count));
     return false;
   }
 
-  writerPos_ += head_->recordBytes() * records.size();
-  return true;
+  writerPos_ += head_->recordBytes() * count;
+  return syncBatch();
 }
 
 void DBFFile::checkHeadField(const DBFHeadField &lField,
@@ -392,6 +668,245 @@ void DBFFile::checkHeadField(const DBFHeadField &lField,
   }
 }
 
+/**
+ * @brief  򿪻ỰỰڼļִ򿪣дʹpread/pwrite
+ *         ÿεöopen/seek/close
+ *
+ * @param readOnly Ƿֻ
+ * @return  򿪳ɹtrueʧܷfalse
+ */
+bool DBFFile::openSession(bool readOnly) {
+  if (storage_) {
+    return true;
+  }
+  std::unique_ptr<DBFFileStorage> storage(new DBFFileStorage);
+  if (!storage->open(name_, readOnly)) {
+    return false;
+  }
+  syncPolicy_ = kSyncNone;
+  storage_ = std::move(storage);
+  return true;
+}
+
+bool DBFFile::closeSession() { return closeStorage(); }
+
+/**
+ * @brief  ֻӳļ֮ĶֱӴӳȡݣٵfread
+ */
+bool DBFFile::openMap() {
+  if (attached_) {
+    return true;
+  }
+  std::unique_ptr<DBFMapStorage> storage(new DBFMapStorage);
+  if (!closeStorage() || !storage->open(name_, false)) {
+    return false;
+  }
+  syncPolicy_ = kSyncNone;
+  storage_ = std::move(storage);
+  return true;
+}
+
+/**
+ * @brief  дӳģʽ¼ֱдӳ׷ʱ󲽳չļ
+ *         ¼Ķдϵͳ
+ *
+ * @param policy ˢ̲ԣˢ̡ÿдmsyncرӳʱmsync
+ * @return  ӳɹtrueʧܷfalse
+ */
+bool DBFFile::openWritableMap(SyncPolicy policy) {
+  if (attached_) {
+    return true;
+  }
+  std::unique_ptr<DBFMapStorage> storage(new DBFMapStorage);
+  if (!closeStorage() || !storage->open(name_, true)) {
+    return false;
+  }
+  syncPolicy_ = policy;
+  storage_ = std::move(storage);
+  return true;
+}
+
+bool DBFFile::closeMap() { return closeStorage(); }
+
+bool DBFFile::isMapped() const { return storage_ && storage_->contiguous(); }
+
+bool DBFFile::sync() { return !storage_ || storage_->sync(); }
+
+bool DBFFile::closeStorage() {
+  if (attached_ || !storage_) {
+    return true;
+  }
+  bool ret = true;
+  if (syncPolicy_ != kSyncNone) {
+    ret = storage_->sync();
+  }
+  ret = storage_->close() && ret;
+  storage_.reset();
+  syncPolicy_ = kSyncNone;
+  return ret;
+}
+
+bool DBFFile::syncBatch() {
+  if (syncPolicy_ != kSyncBatch || !storage_) {
+    return true;
+  }
+  return storage_->sync();
+}
+
+/**
+ * @brief  ʼ룺ԤƼ¼Ԥ̿ռ䣬֮appendWritenֻѼ¼
+ *         ܽ󻺳˲д¼ļ־commitBulkLoad
+ *         ʱֻдһΣύǰ߿ǵǰļ¼
+ *         writeHeadreadHead֮ãڼֻӦappendWriten
+ *
+ * @param expectedRecords Ԥ׷ӵļ¼0ʾԤ
+ * @param bufferBytes дС
+ * @return  ɹtrueʧܷfalse
+ */
+bool DBFFile::beginBulkLoad(size_t expectedRecords, size_t bufferBytes) {
+  if (inBulkLoad()) {
+    return true;
+  }
+  if (!checkRecordWritable()) {
+    return false;
+  }
+  bulkSession_ = !inSession();
+  if (bulkSession_ && !openSession()) {
+    bulkSession_ = false;
+    return false;
+  }
+
+  size_t recordBytes = static_cast<size_t>(head_->recordBytes());
+  if (expectedRecords > 0 &&
+      !storage_->reserve(writerPos_ + expectedRecords * recordBytes + 1)) {
+    SPDLOG_WARN("Bulk load preallocate failed, records : {}", expectedRecords);
+  }
+
+  bulkBytes_ = std::max(bufferBytes, recordBytes);
+  bulkPos_ = writerPos_;
+  bulkFailed_ = false;
+  bulkBuf_.reset(new DBFBuffer(bulkBytes_ + recordBytes));
+  return true;
+}
+
+/**
+ * @brief  дʣļ¼ļ־ٸһļͷеļ¼
+ *         ;дʧʱfalseļͷ԰Ѿ̵ļ¼£
+ *         ־дһ̼¼֮
+ */
+bool DBFFile::commitBulkLoad() {
+  if (!inBulkLoad()) {
+    return true;
+  }
+
+  bool ret = !bulkFailed_;
+  if (ret) {
+    bulkBuf_->appendChar(kEndFileFlag);
+    ret = flushBulk();
+  }
+  if (!ret) {
+    char flag = kEndFileFlag;
+    storage_->write(&flag, sizeof flag, bulkPos_);
+  }
+  ret = writeRecordNumber() && syncBatch() && ret;
+  bulkBuf_.reset();
+  bulkFailed_ = false;
+  if (bulkSession_) {
+    bulkSession_ = false;
+    ret = closeSession() && ret;
+  }
+  return ret;
+}
+
+/**
+ * @brief  дbulkPos_ʧʱеļ¼ụ̂˼¼
+ *         bulkFailed_Щ¼appendWritenѾعtrue֮׷Ӻ
+ *         commitBulkLoadfalse÷֪ݶʧ
+ */
+bool DBFFile::flushBulk() {
+  size_t len = bulkBuf_->readableBytes();
+  if (len == 0) {
+    return true;
+  }
+  if (!storage_->write(bulkBuf_->peek(), len, bulkPos_)) {
+    size_t pending = writerPos_ - bulkPos_;
+    head_->setRecordNumber(head_->recordNumber() -
+                           static_cast<int32_t>(pending / head_->recordBytes()));
+    writerPos_ = bulkPos_;
+    bulkBuf_->retrieveAll();
+    bulkFailed_ = true;
+    return false;
+  }
+  bulkPos_ = writerPos_;
+  bulkBuf_->retrieveAll();
+  return true;
+}
+
+/**
+ * @brief  ˳ɨ¼ÿηһ¼ͼڴռòchunkBytes
+ */
+DBFScanner DBFFile::scan(size_t chunkBytes) {
+  return DBFScanner(*this, chunkBytes);
+}
+
+/**
+ * @brief  ֻɨÿ¼ɾ־ɴ¼λͼiλӦi¼
+ *         ӳģʽֱɨӳchunkBytesֿȡ
+ */
+bool DBFFile::scanLive(DBFLiveBitmap &bitmap, size_t chunkBytes) {
+  if (inBulkLoad() && !flushBulk()) {
+    return false;
+  }
+
+  auto recordBytes = static_cast<size_t>(head_->recordBytes());
+  auto first = static_cast<size_t>(head_->headerBytes());
+  size_t records = 0;
+  if (recordBytes > 0 && writerPos_ > first) {
+    records = (writerPos_ - first) / recordBytes;
+  }
+  bitmap.reset(records);
+  if (records == 0) {
+    return true;
+  }
+
+  if (isMapped()) {
+    const char *data = storage_->data(first, records * recordBytes);
+    if (data == nullptr) {
+      SPDLOG_WARN("Scan live records failure : {}", name_);
+      return false;
+    }
+    bitmap.scan(data, 0, records, recordBytes);
+    return true;
+  }
+
+  bool ownSession = false;
+  if (!inSession()) {
+    if (!openSession(true)) {
+      return false;
+    }
+    ownSession = true;
+  }
+  storage_->adviseSequential(first, records * recordBytes);
+
+  size_t chunkRecords = std::max<size_t>(chunkBytes / recordBytes, 1);
+  std::vector<char> chunk(chunkRecords * recordBytes);
+  bool ret = true;
+  for (size_t index = 0; index < records; index += chunkRecords) {
+    size_t count = std::min(chunkRecords, records - index);
+    if (!read(chunk.data(), static_cast<long>(first + index * recordBytes),
+              count * recordBytes)) {
+      ret = false;
+      break;
+    }
+    bitmap.scan(chunk.data(), index, count, recordBytes);
+  }
+
+  if (ownSession) {
+    ret = closeSession() && ret;
+  }
+  return ret;
+}
+
 bool DBFFile::open(const std::string &mode) {
   file_ = fopen(name_.c_str(), mode.c_str());
   if (file_ == nullptr) {
@@ -573,6 +1088,10 @@ bool DBFFile::flush() {
 }
 
 bool DBFFile::read(DBFBuffer &buf) {
+  if (storage_) {
+    return storage_->read(buf.peek(), buf.readableBytes(), readerPos_);
+  }
+
   if (!open("rb")) {
     return false;
   }
@@ -597,6 +1116,11 @@ bool DBFFile::read(DBFBuffer &buf) {
 }
 
 bool DBFFile::appendWriten(const DBFBuffer &buf) {
+  if (storage_) {
+    return storage_->truncate(0) &&
+           storage_->write(buf.peek(), buf.readableBytes(), 0);
+  }
+
   if (!open("wb+")) {
     return false;
   }
@@ -616,6 +1140,10 @@ bool DBFFile::appendWriten(const DBFBuffer &buf) {
 }
 
 bool DBFFile::appendRecordWriten(const DBFBuffer &buf) {
+  if (storage_) {
+    return storage_->write(buf.peek(), buf.readableBytes(), writerPos_);
+  }
+
   if (!open("r+b")) {
     return false;
   }
@@ -640,6 +1168,10 @@ bool DBFFile::appendRecordWriten(const DBFBuffer &buf) {
 }
 
 bool DBFFile::write(const char *buf, long start, size_t len) {
+  if (storage_) {
+    return storage_->write(buf, len, static_cast<size_t>(start));
+  }
+
   if (!open("rb+")) {
     return false;
   }
@@ -664,6 +1196,10 @@ bool DBFFile::write(const char *buf, long start, size_t len) {
 }
 
 bool DBFFile::read(char *buf, long start, size_t len) {
+  if (storage_) {
+    return storage_->read(buf, len, static_cast<size_t>(start));
+  }
+
   if (!open("rb")) {
     return false;
   }
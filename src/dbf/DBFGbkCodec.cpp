@@ -0,0 +1,216 @@
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <iconv.h>
+#endif
+
+#include <spdlog/spdlog.h>
+#include <util/StringUtil.hpp>
+
+#include "dbf/DBFGbkCodec.h"
+
+namespace dbf {
+const size_t DBFGbkCodec::npos;
+
+namespace {
+const size_t kTrailCount = 0xFF - 0x40;
+
+inline size_t gbkIndex(unsigned lead, unsigned trail) {
+  return (lead - 0x81) * kTrailCount + (trail - 0x40);
+}
+
+inline bool isContinuation(unsigned char ch) { return (ch & 0xC0) == 0x80; }
+} // namespace
+
+/**
+ * @brief  GBK˫ֻֽڵһʹʱһΣ˫ֽ뽻ϵͳ
+ *         ҳתWindowsΪ936ҳƽ̨ΪiconvõӦUnicode
+ *         ٷUnicodeGBKı֮תֻ
+ */
+const DBFGbkCodec &DBFGbkCodec::instance() {
+  static DBFGbkCodec codec;
+  return codec;
+}
+
+DBFGbkCodec::DBFGbkCodec() : valid_(false) {
+  valid_ = build();
+  if (!valid_) {
+    SPDLOG_WARN("Build gbk code table failure, only ascii can be converted");
+  }
+}
+
+bool DBFGbkCodec::build() {
+  toUnicode_.assign((kLeadEnd - kLeadBegin) * kTrailCount, 0);
+  toGbk_.assign(0x10000, 0);
+
+#ifndef _WIN32
+  iconv_t cd = iconv_open("UTF-16LE", "GBK");
+  if (cd == reinterpret_cast<iconv_t>(-1)) {
+    SPDLOG_WARN("Open iconv failure : {}", strerror(errno));
+    return false;
+  }
+#endif
+
+  size_t mapped = 0;
+  for (unsigned lead = kLeadBegin; lead != kLeadEnd; ++lead) {
+    for (unsigned trail = kTrailBegin; trail != kTrailEnd; ++trail) {
+      char in[2] = {static_cast<char>(lead), static_cast<char>(trail)};
+      uint16_t code = 0;
+#ifdef _WIN32
+      wchar_t wide = 0;
+      if (MultiByteToWideChar(936, MB_ERR_INVALID_CHARS, in, 2, &wide, 1) !=
+          1) {
+        continue;
+      }
+      code = static_cast<uint16_t>(wide);
+#else
+      unsigned char out[4] = {0};
+      char *inPtr = in;
+      char *outPtr = reinterpret_cast<char *>(out);
+      size_t inLeft = sizeof in;
+      size_t outLeft = sizeof out;
+      iconv(cd, nullptr, nullptr, nullptr, nullptr);
+      if (iconv(cd, &inPtr, &inLeft, &outPtr, &outLeft) ==
+              static_cast<size_t>(-1) ||
+          inLeft != 0 || outLeft != 2) {
+        continue;
+      }
+      code = static_cast<uint16_t>(out[0] | (out[1] << 8));
+#endif
+      if (code < 0x80) {
+        continue;
+      }
+      toUnicode_[gbkIndex(lead, trail)] = code;
+      if (toGbk_[code] == 0) {
+        toGbk_[code] = static_cast<uint16_t>((lead << 8) | trail);
+      }
+      ++mapped;
+    }
+  }
+
+#ifndef _WIN32
+  iconv_close(cd);
+#endif
+  return mapped > 0;
+}
+
+/**
+ * @brief  GBKתUTF-8ASCIISSE2жο˫ֽ
+ *         д÷ṩdst
+ *
+ * @param cap dstmaxUtf8Bytes(len)㹻
+ * @return  дdstַֽǷGBKʱnpos
+ */
+size_t DBFGbkCodec::toUtf8(const char *src, size_t len, char *dst,
+                           size_t cap) const {
+  size_t out = 0;
+  size_t index = 0;
+  while (index != len) {
+    size_t ascii = util::asciiPrefix(src + index, len - index);
+    if (ascii > 0) {
+      if (out + ascii > cap) {
+        return npos;
+      }
+      std::memcpy(dst + out, src + index, ascii);
+      out += ascii;
+      index += ascii;
+      continue;
+    }
+
+    auto lead = static_cast<unsigned char>(src[index]);
+    if (!valid_ || index + 1 == len || lead < kLeadBegin || lead == kLeadEnd) {
+      return npos;
+    }
+    auto trail = static_cast<unsigned char>(src[index + 1]);
+    if (trail < kTrailBegin || trail == kTrailEnd) {
+      return npos;
+    }
+    uint16_t code = toUnicode_[gbkIndex(lead, trail)];
+    if (code == 0) {
+      return npos;
+    }
+
+    if (code < 0x800) {
+      if (out + 2 > cap) {
+        return npos;
+      }
+      dst[out++] = static_cast<char>(0xC0 | (code >> 6));
+    } else {
+      if (out + 3 > cap) {
+        return npos;
+      }
+      dst[out++] = static_cast<char>(0xE0 | (code >> 12));
+      dst[out++] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    }
+    dst[out++] = static_cast<char>(0x80 | (code & 0x3F));
+    index += 2;
+  }
+  return out;
+}
+
+/**
+ * @brief  UTF-8תGBKASCIIοఴ
+ *         ǷUTF-8GBKûеַʱnpos
+ */
+size_t DBFGbkCodec::toGbk(const char *src, size_t len, char *dst,
+                          size_t cap) const {
+  size_t out = 0;
+  size_t index = 0;
+  while (index != len) {
+    size_t ascii = util::asciiPrefix(src + index, len - index);
+    if (ascii > 0) {
+      if (out + ascii > cap) {
+        return npos;
+      }
+      std::memcpy(dst + out, src + index, ascii);
+      out += ascii;
+      index += ascii;
+      continue;
+    }
+
+    auto lead = static_cast<unsigned char>(src[index]);
+    uint32_t code = 0;
+    if ((lead & 0xE0) == 0xC0) {
+      if (index + 1 >= len ||
+          !isContinuation(static_cast<unsigned char>(src[index + 1]))) {
+        return npos;
+      }
+      code = ((lead & 0x1Fu) << 6) |
+             (static_cast<unsigned char>(src[index + 1]) & 0x3Fu);
+      if (code < 0x80) {
+        return npos;
+      }
+      index += 2;
+    } else if ((lead & 0xF0) == 0xE0) {
+      if (index + 2 >= len ||
+          !isContinuation(static_cast<unsigned char>(src[index + 1])) ||
+          !isContinuation(static_cast<unsigned char>(src[index + 2]))) {
+        return npos;
+      }
+      code = ((lead & 0x0Fu) << 12) |
+             ((static_cast<unsigned char>(src[index + 1]) & 0x3Fu) << 6) |
+             (static_cast<unsigned char>(src[index + 2]) & 0x3Fu);
+      if (code < 0x800) {
+        return npos;
+      }
+      index += 3;
+    } else {
+      return npos;
+    }
+
+    uint16_t gbk = valid_ ? toGbk_[code] : 0;
+    if (gbk == 0 || out + 2 > cap) {
+      return npos;
+    }
+    dst[out++] = static_cast<char>(gbk >> 8);
+    dst[out++] = static_cast<char>(gbk & 0xFF);
+  }
+  return out;
+}
+} // namespace dbf
@@ -0,0 +1,86 @@
+#include <boost/endian/conversion.hpp>
+
+#include "dbf/DBFFile.h"
+#include "dbf/DBFHead.h"
+#include "dbf/DBFIoBatch.h"
+
+namespace dbf {
+/**
+ * @brief  IOһѯԶļİƫƶдͼ¼ˢȵǼǣ
+ *         һsubmit()/wait()ִСÿDBFFileеĶдԭ
+ *         ļڻỰʱһpread/pwriteopen/seek/close
+ */
+DBFIoBatch::DBFIoBatch() : submitted_(0), failed_(false) {}
+
+size_t DBFIoBatch::prepareRead(DBFFile &file, char *buf, size_t pos,
+                               size_t len) {
+  return prepare(kRead, file, buf, nullptr, pos, len);
+}
+
+size_t DBFIoBatch::prepareWrite(DBFFile &file, const char *buf, size_t pos,
+                                size_t len) {
+  return prepare(kWrite, file, nullptr, buf, pos, len);
+}
+
+size_t DBFIoBatch::prepareRecordNumber(DBFFile &file) {
+  return prepare(kRecordNumber, file, nullptr, nullptr,
+                 static_cast<size_t>(DBFFile::kRecorNumIndex),
+                 sizeof(int32_t));
+}
+
+bool DBFIoBatch::submit() {
+  for (; submitted_ < requests_.size(); ++submitted_) {
+    auto &request = requests_[submitted_];
+    complete(request, execute(request));
+  }
+  return !failed_;
+}
+
+bool DBFIoBatch::wait() { return submit(); }
+
+void DBFIoBatch::clear() {
+  requests_.clear();
+  submitted_ = 0;
+  failed_ = false;
+}
+
+size_t DBFIoBatch::prepare(Kind kind, DBFFile &file, char *buf,
+                           const char *writeBuf, size_t pos, size_t len) {
+  requests_.emplace_back();
+  auto &request = requests_.back();
+  request.kind = kind;
+  request.file = &file;
+  request.buf = kind == kRecordNumber
+                    ? reinterpret_cast<char *>(&request.recordNumber)
+                    : buf;
+  request.writeBuf = writeBuf;
+  request.pos = pos;
+  request.len = len;
+  request.recordNumber = 0;
+  request.done = false;
+  request.ok = false;
+  return requests_.size() - 1;
+}
+
+bool DBFIoBatch::execute(Request &request) {
+  if (request.kind == kWrite) {
+    return request.file->write(request.writeBuf,
+                               static_cast<long>(request.pos), request.len);
+  }
+  return request.file->read(request.buf, static_cast<long>(request.pos),
+                            request.len);
+}
+
+void DBFIoBatch::complete(Request &request, bool ok) {
+  request.done = true;
+  request.ok = ok;
+  if (!ok) {
+    failed_ = true;
+    return;
+  }
+  if (request.kind == kRecordNumber) {
+    request.file->head()->setRecordNumber(
+        boost::endian::little_to_native(request.recordNumber));
+  }
+}
+} // namespace dbf
@@ -0,0 +1,202 @@
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DBF_LIVE_AVX2 1
+#define DBF_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#include <intrin.h>
+#define DBF_LIVE_AVX2 1
+#define DBF_AVX2_TARGET
+#else
+#define DBF_LIVE_AVX2 0
+#endif
+
+#include "dbf/DBFLiveBitmap.h"
+
+namespace dbf {
+namespace {
+const size_t kWordBits = 64;
+
+inline unsigned popCount(uint64_t val) {
+#ifdef _MSC_VER
+#ifdef _M_X64
+  return static_cast<unsigned>(__popcnt64(val));
+#else
+  return __popcnt(static_cast<uint32_t>(val)) +
+         __popcnt(static_cast<uint32_t>(val >> 32));
+#endif
+#else
+  return static_cast<unsigned>(__builtin_popcountll(val));
+#endif
+}
+
+inline unsigned countTrailingZeros(uint64_t val) {
+#ifdef _MSC_VER
+  unsigned long index = 0;
+#ifdef _M_X64
+  _BitScanForward64(&index, val);
+#else
+  if (!_BitScanForward(&index, static_cast<uint32_t>(val))) {
+    _BitScanForward(&index, static_cast<uint32_t>(val >> 32));
+    index += 32;
+  }
+#endif
+  return index;
+#else
+  return static_cast<unsigned>(__builtin_ctzll(val));
+#endif
+}
+
+uint64_t scalarWord(const char *data, size_t records, size_t stride,
+                    char deleteFlag) {
+  uint64_t word = 0;
+  for (size_t i = 0; i < records; ++i) {
+    word |= static_cast<uint64_t>(data[i * stride] != deleteFlag) << i;
+  }
+  return word;
+}
+
+#if DBF_LIVE_AVX2
+/**
+ * @brief  һgatherȡ8¼ɾ־ڵ4ֽڣȽϵֽڵõ8λ룬
+ *         8ƴ64¼Ĵλ÷֤һgatherԽ
+ */
+DBF_AVX2_TARGET uint64_t avx2Word(const char *data, size_t stride,
+                                  char deleteFlag) {
+  const int step = static_cast<int>(stride);
+  const __m256i index = _mm256_setr_epi32(0, step, 2 * step, 3 * step,
+                                          4 * step, 5 * step, 6 * step,
+                                          7 * step);
+  const __m256i lowByte = _mm256_set1_epi32(0xFF);
+  const __m256i flag =
+      _mm256_set1_epi32(static_cast<unsigned char>(deleteFlag));
+
+  uint64_t deleted = 0;
+  for (unsigned i = 0; i < 8; ++i) {
+    __m256i val = _mm256_i32gather_epi32(
+        reinterpret_cast<const int *>(data + i * 8 * stride), index, 1);
+    __m256i eq = _mm256_cmpeq_epi32(_mm256_and_si256(val, lowByte), flag);
+    deleted |= static_cast<uint64_t>(static_cast<unsigned>(
+                   _mm256_movemask_ps(_mm256_castsi256_ps(eq))))
+               << (i * 8);
+  }
+  return ~deleted;
+}
+
+bool detectAvx2() {
+#ifdef _MSC_VER
+  int info[4] = {0};
+  __cpuid(info, 0);
+  if (info[0] < 7) {
+    return false;
+  }
+  __cpuid(info, 1);
+  const int osxsave = 1 << 27;
+  const int avx = 1 << 28;
+  if ((info[2] & osxsave) == 0 || (info[2] & avx) == 0 ||
+      (_xgetbv(0) & 0x6) != 0x6) {
+    return false;
+  }
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif
+} // namespace
+
+void DBFLiveBitmap::reset(size_t records) {
+  words_.assign((records + kWordBits - 1) / kWordBits, 0);
+  size_ = records;
+  liveCount_ = 0;
+}
+
+/**
+ * @brief  ɨrecords¼ɾ־д[first, first + records)λ
+ *         ֻÿ¼ĵһֽڣ¼
+ *
+ * @param data first¼ʼַٿɶrecords * strideֽ
+ * @param stride ¼
+ * @return ɨĴ¼
+ */
+size_t DBFLiveBitmap::scan(const char *data, size_t first, size_t records,
+                           size_t stride) {
+  if (first + records > size_) {
+    size_t size = first + records;
+    words_.resize((size + kWordBits - 1) / kWordBits, 0);
+    size_ = size;
+  }
+
+  size_t live = 0;
+  size_t done = 0;
+  while (done < records) {
+    size_t count = std::min(kWordBits, records - done);
+    const char *block = data + done * stride;
+    uint64_t word = 0;
+#if DBF_LIVE_AVX2
+    if (accelerated() && count == kWordBits &&
+        (done + kWordBits - 1) * stride + sizeof(int) <= records * stride) {
+      word = avx2Word(block, stride, kDeleteFlag);
+    } else {
+      word = scalarWord(block, count, stride, kDeleteFlag);
+    }
+#else
+    word = scalarWord(block, count, stride, kDeleteFlag);
+#endif
+    if (count < kWordBits) {
+      word &= (static_cast<uint64_t>(1) << count) - 1;
+    }
+    live += popCount(word);
+
+    size_t bit = first + done;
+    size_t index = bit / kWordBits;
+    size_t shift = bit % kWordBits;
+    uint64_t mask = count < kWordBits
+                        ? (static_cast<uint64_t>(1) << count) - 1
+                        : ~static_cast<uint64_t>(0);
+    liveCount_ -= popCount(words_[index] & (mask << shift));
+    words_[index] = (words_[index] & ~(mask << shift)) | (word << shift);
+    if (shift != 0 && shift + count > kWordBits) {
+      uint64_t high = mask >> (kWordBits - shift);
+      liveCount_ -= popCount(words_[index + 1] & high);
+      words_[index + 1] =
+          (words_[index + 1] & ~high) | (word >> (kWordBits - shift));
+    }
+    done += count;
+  }
+  liveCount_ += live;
+  return live;
+}
+
+/**
+ * @brief  index֮һ¼ţûʱsize()
+ */
+size_t DBFLiveBitmap::nextLive(size_t index) const {
+  if (index >= size_) {
+    return size_;
+  }
+  size_t word = index / kWordBits;
+  uint64_t bits =
+      words_[word] & (~static_cast<uint64_t>(0) << (index % kWordBits));
+  while (bits == 0) {
+    if (++word == words_.size()) {
+      return size_;
+    }
+    bits = words_[word];
+  }
+  return std::min(word * kWordBits + countTrailingZeros(bits), size_);
+}
+
+bool DBFLiveBitmap::accelerated() {
+#if DBF_LIVE_AVX2
+  static const bool avx2 = detectAvx2();
+  return avx2;
+#else
+  return false;
+#endif
+}
+} // namespace dbf
@@ -0,0 +1,358 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include "dbf/DBFMapping.h"
+
+namespace dbf {
+const size_t DBFMapping::kMinGrowBytes;
+const size_t DBFMapping::kMaxGrowBytes;
+
+#ifdef _WIN32
+DBFMapping::DBFMapping()
+    : opened_(false), writable_(false), data_(nullptr), size_(0),
+      capacity_(0), dirtyBegin_(0), dirtyEnd_(0), file_(INVALID_HANDLE_VALUE),
+      mapping_(nullptr) {}
+#else
+DBFMapping::DBFMapping()
+    : opened_(false), writable_(false), data_(nullptr), size_(0),
+      capacity_(0), dirtyBegin_(0), dirtyEnd_(0), fd_(-1) {}
+#endif
+
+DBFMapping::~DBFMapping() { close(); }
+
+#ifdef _WIN32
+bool DBFMapping::open(const std::string &name, bool writable) {
+  if (opened_) {
+    return true;
+  }
+  DWORD access = writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ;
+  file_ = CreateFileA(name.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                      nullptr, writable ? OPEN_ALWAYS : OPEN_EXISTING,
+                      FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file_ == INVALID_HANDLE_VALUE) {
+    SPDLOG_WARN("Open failure : {}, error : {}", name, GetLastError());
+    return false;
+  }
+  opened_ = true;
+  writable_ = writable;
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file_, &fileSize)) {
+    SPDLOG_WARN("Get file size failure : {}", GetLastError());
+    close();
+    return false;
+  }
+  size_ = static_cast<size_t>(fileSize.QuadPart);
+  if (!map(size_)) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool DBFMapping::close() {
+  if (!opened_) {
+    return true;
+  }
+  bool ret = unmap();
+  if (writable_ && !truncate(size_)) {
+    ret = false;
+  }
+  CloseHandle(file_);
+  file_ = INVALID_HANDLE_VALUE;
+  opened_ = false;
+  writable_ = false;
+  size_ = 0;
+  dirtyBegin_ = dirtyEnd_ = 0;
+  return ret;
+}
+
+bool DBFMapping::remap() {
+  if (!opened_) {
+    return false;
+  }
+  if (writable_) {
+    return true;
+  }
+  if (!unmap()) {
+    return false;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file_, &fileSize)) {
+    SPDLOG_WARN("Get file size failure : {}", GetLastError());
+    return false;
+  }
+  size_ = static_cast<size_t>(fileSize.QuadPart);
+  return map(size_);
+}
+
+bool DBFMapping::sync() {
+  if (!writable_ || dirtyEnd_ <= dirtyBegin_) {
+    return true;
+  }
+  bool ret = true;
+  if (!FlushViewOfFile(data_ + dirtyBegin_, dirtyEnd_ - dirtyBegin_) ||
+      !FlushFileBuffers(file_)) {
+    SPDLOG_WARN("Flush view of file failure : {}", GetLastError());
+    ret = false;
+  }
+  dirtyBegin_ = dirtyEnd_ = 0;
+  return ret;
+}
+
+bool DBFMapping::map(size_t capacity) {
+  capacity_ = capacity;
+  if (0 == capacity) {
+    return true;
+  }
+
+  // дӳĳȳļʱCreateFileMappingԶչļ
+  uint64_t len = capacity;
+  mapping_ = CreateFileMappingA(file_, nullptr,
+                                writable_ ? PAGE_READWRITE : PAGE_READONLY,
+                                static_cast<DWORD>(len >> 32),
+                                static_cast<DWORD>(len & 0xFFFFFFFF), nullptr);
+  if (mapping_ == nullptr) {
+    SPDLOG_WARN("Create file mapping failure : {}", GetLastError());
+    capacity_ = 0;
+    return false;
+  }
+  DWORD access = writable_ ? (FILE_MAP_READ | FILE_MAP_WRITE) : FILE_MAP_READ;
+  data_ = static_cast<char *>(MapViewOfFile(mapping_, access, 0, 0, 0));
+  if (data_ == nullptr) {
+    SPDLOG_WARN("Map view of file failure : {}", GetLastError());
+    CloseHandle(mapping_);
+    mapping_ = nullptr;
+    capacity_ = 0;
+    return false;
+  }
+  return true;
+}
+
+bool DBFMapping::unmap() {
+  bool ret = true;
+  if (data_ != nullptr && !UnmapViewOfFile(data_)) {
+    SPDLOG_WARN("Unmap view of file failure : {}", GetLastError());
+    ret = false;
+  }
+  if (mapping_ != nullptr) {
+    CloseHandle(mapping_);
+  }
+  data_ = nullptr;
+  mapping_ = nullptr;
+  capacity_ = 0;
+  return ret;
+}
+
+bool DBFMapping::truncate(size_t size) {
+  LARGE_INTEGER pos;
+  pos.QuadPart = static_cast<LONGLONG>(size);
+  if (!SetFilePointerEx(file_, pos, nullptr, FILE_BEGIN) ||
+      !SetEndOfFile(file_)) {
+    SPDLOG_WARN("Truncate failure : {}", GetLastError());
+    return false;
+  }
+  return true;
+}
+#else
+bool DBFMapping::open(const std::string &name, bool writable) {
+  if (opened_) {
+    return true;
+  }
+  int flags = writable ? (O_RDWR | O_CREAT) : O_RDONLY;
+  do {
+    fd_ = ::open(name.c_str(), flags | O_CLOEXEC, 0644);
+  } while (-1 == fd_ && errno == EINTR);
+  if (-1 == fd_) {
+    SPDLOG_WARN("Open failure : {}", strerror(errno));
+    return false;
+  }
+  opened_ = true;
+  writable_ = writable;
+
+  struct stat st;
+  if (0 != fstat(fd_, &st)) {
+    SPDLOG_WARN("Stat failure : {}", strerror(errno));
+    close();
+    return false;
+  }
+  size_ = static_cast<size_t>(st.st_size);
+  if (!map(size_)) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool DBFMapping::close() {
+  if (!opened_) {
+    return true;
+  }
+  bool ret = unmap();
+  if (writable_ && !truncate(size_)) {
+    ret = false;
+  }
+  ::close(fd_);
+  fd_ = -1;
+  opened_ = false;
+  writable_ = false;
+  size_ = 0;
+  dirtyBegin_ = dirtyEnd_ = 0;
+  return ret;
+}
+
+/**
+ * @brief  ļ׷Ӻӳ䣬ʹдļ¼ɼ
+ *         дӳɱάȣӳ
+ */
+bool DBFMapping::remap() {
+  if (!opened_) {
+    return false;
+  }
+  if (writable_) {
+    return true;
+  }
+  if (!unmap()) {
+    return false;
+  }
+  struct stat st;
+  if (0 != fstat(fd_, &st)) {
+    SPDLOG_WARN("Stat failure : {}", strerror(errno));
+    return false;
+  }
+  size_ = static_cast<size_t>(st.st_size);
+  return map(size_);
+}
+
+bool DBFMapping::sync() {
+  if (!writable_ || dirtyEnd_ <= dirtyBegin_) {
+    return true;
+  }
+  static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t begin = dirtyBegin_ / pageSize * pageSize;
+  size_t end = std::min(dirtyEnd_, capacity_);
+  dirtyBegin_ = dirtyEnd_ = 0;
+  if (end > begin && 0 != msync(data_ + begin, end - begin, MS_SYNC)) {
+    SPDLOG_WARN("Msync failure : {}", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool DBFMapping::map(size_t capacity) {
+  capacity_ = capacity;
+  if (0 == capacity) {
+    return true;
+  }
+
+  int prot = writable_ ? (PROT_READ | PROT_WRITE) : PROT_READ;
+  void *addr = mmap(nullptr, capacity, prot, MAP_SHARED, fd_, 0);
+  if (addr == MAP_FAILED) {
+    SPDLOG_WARN("Mmap failure : {}", strerror(errno));
+    capacity_ = 0;
+    return false;
+  }
+  data_ = static_cast<char *>(addr);
+  return true;
+}
+
+bool DBFMapping::unmap() {
+  bool ret = true;
+  if (data_ != nullptr && 0 != munmap(data_, capacity_)) {
+    SPDLOG_WARN("Munmap failure : {}", strerror(errno));
+    ret = false;
+  }
+  data_ = nullptr;
+  capacity_ = 0;
+  return ret;
+}
+
+bool DBFMapping::truncate(size_t size) {
+  if (0 != ftruncate(fd_, static_cast<off_t>(size))) {
+    SPDLOG_WARN("Truncate failure : {}", strerror(errno));
+    return false;
+  }
+  return true;
+}
+#endif
+
+/**
+ * @brief  дӳ߼ȣӳʱ󲽳չļӳ䣬
+ *         չԭȡõӳַʧЧ
+ */
+bool DBFMapping::resize(size_t size) {
+  if (!writable_) {
+    SPDLOG_WARN("Resize failure : mapping is read only");
+    return false;
+  }
+  if (size <= capacity_) {
+    size_ = size;
+    return true;
+  }
+
+  size_t step = std::min(std::max(capacity_, kMinGrowBytes), kMaxGrowBytes);
+  size_t capacity = (size + step - 1) / step * step;
+#ifdef __linux__
+  if (data_ != nullptr) {
+    if (!truncate(capacity)) {
+      return false;
+    }
+    void *addr = mremap(data_, capacity_, capacity, MREMAP_MAYMOVE);
+    if (addr == MAP_FAILED) {
+      SPDLOG_WARN("Mremap failure : {}", strerror(errno));
+      return false;
+    }
+    data_ = static_cast<char *>(addr);
+    capacity_ = capacity;
+    size_ = size;
+    return true;
+  }
+#endif
+  if (!unmap()) {
+    return false;
+  }
+#ifndef _WIN32
+  if (!truncate(capacity)) {
+    return false;
+  }
+#endif
+  if (!map(capacity)) {
+    return false;
+  }
+  size_ = size;
+  return true;
+}
+
+void DBFMapping::adviseSequential() {
+#ifndef _WIN32
+  if (data_ != nullptr) {
+    madvise(data_, capacity_, MADV_SEQUENTIAL);
+  }
+#endif
+}
+
+void DBFMapping::markDirty(size_t pos, size_t len) {
+  if (dirtyEnd_ <= dirtyBegin_) {
+    dirtyBegin_ = pos;
+    dirtyEnd_ = pos + len;
+  } else {
+    dirtyBegin_ = std::min(dirtyBegin_, pos);
+    dirtyEnd_ = std::max(dirtyEnd_, pos + len);
+  }
+}
+} // namespace dbf
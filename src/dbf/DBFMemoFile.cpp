@@ -0,0 +1,257 @@
+#include <cctype>
+#include <cstring>
+
+#include <boost/endian/conversion.hpp>
+#include <spdlog/spdlog.h>
+
+#include "dbf/DBFMemoFile.h"
+
+namespace dbf {
+const size_t DBFMemoFile::kHeaderBytes;
+const size_t DBFMemoFile::kDbtBlockBytes;
+const size_t DBFMemoFile::kFptBlockBytes;
+const size_t DBFMemoFile::kFptBlockHeadBytes;
+const size_t DBFMemoFile::kBatchBytes;
+
+namespace {
+const uint32_t kFptTextType = 1;
+
+uint32_t loadLittle32(const char *data) {
+  uint32_t val = 0;
+  std::memcpy(&val, data, sizeof val);
+  return boost::endian::little_to_native(val);
+}
+
+uint32_t loadBig32(const char *data) {
+  uint32_t val = 0;
+  std::memcpy(&val, data, sizeof val);
+  return boost::endian::big_to_native(val);
+}
+
+template <typename T> void storeBig(char *data, T val) {
+  val = boost::endian::native_to_big(val);
+  std::memcpy(data, &val, sizeof val);
+}
+
+void appendBig32(DBFBuffer &buf, uint32_t val) {
+  buf.ensureWritableBytes(sizeof val);
+  storeBig(buf.beginWrite(), val);
+  buf.hasWritten(sizeof val);
+}
+} // namespace
+
+/**
+ * @brief  עļ(.dbt/.fpt)¼ֻţעڵһζȡʱ
+ *         ӳļŶλصͼֱָӳ
+ *
+ * @param blockBytes С0ʾʽȡĬֵdbtΪ512fptΪ64
+ *                   еfptļʱļͷеĿСΪ׼
+ */
+DBFMemoFile::DBFMemoFile(const std::string &name, Format format,
+                         size_t blockBytes)
+    : name_(name), format_(format),
+      blockBytes_(blockBytes != 0
+                      ? blockBytes
+                      : (format == kDbt ? kDbtBlockBytes : kFptBlockBytes)),
+      flushedBlock_(0), nextBlock_(0) {}
+
+DBFMemoFile::~DBFMemoFile() { close(); }
+
+bool DBFMemoFile::open(bool writable) {
+  if (isOpen()) {
+    return true;
+  }
+  if (!mapping_.open(name_, writable)) {
+    return false;
+  }
+
+  if (mapping_.size() == 0 && writable) {
+    if (!mapping_.resize(kHeaderBytes)) {
+      mapping_.close();
+      return false;
+    }
+    std::memset(mapping_.data(), 0, kHeaderBytes);
+    mapping_.markDirty(0, kHeaderBytes);
+    nextBlock_ = static_cast<uint32_t>((kHeaderBytes + blockBytes_ - 1) /
+                                       blockBytes_);
+    writeHeader();
+  } else if (!readHeader()) {
+    mapping_.close();
+    return false;
+  }
+  flushedBlock_ = nextBlock_;
+  return true;
+}
+
+bool DBFMemoFile::close() {
+  if (!isOpen()) {
+    return true;
+  }
+  bool ret = flush();
+  return mapping_.close() && ret;
+}
+
+/**
+ * @brief  ȡעݣΪ0ʾûбע
+ *         ļδʱֻʽ򿪣ֻбʵĿŻ̡
+ *         δдĿԽӳ䶼ƶӳ
+ *         ͼֻһread/append/flush/close֮ǰЧ
+ */
+boost::string_view DBFMemoFile::read(uint32_t block) {
+  if (block == 0 || (!isOpen() && !open(false))) {
+    return boost::string_view();
+  }
+  if (block >= flushedBlock_ && block < nextBlock_ && !flush()) {
+    return boost::string_view();
+  }
+
+  size_t pos = static_cast<size_t>(block) * blockBytes_;
+  if (format_ == kFpt) {
+    auto head = bytesAt(pos, kFptBlockHeadBytes);
+    if (head.empty()) {
+      return head;
+    }
+    return bytesAt(pos + kFptBlockHeadBytes, loadBig32(head.data() + 4));
+  }
+
+  //dbtûгֶΣ0x1A
+  auto rest = bytesAt(pos, 0);
+  if (rest.data() == nullptr) {
+    return rest;
+  }
+  rest = boost::string_view(rest.data(), mapping_.size() - pos);
+  auto end = rest.find(kDbtEndFlag);
+  return end == boost::string_view::npos ? rest : rest.substr(0, end);
+}
+
+/**
+ * @brief  ׷һעţڻ
+ *         kBatchBytesflush/closeʱųдӳļͷ
+ *
+ * @return  עĿţʧܷ0дʧʱעͬռĿ
+ *          һ֮ǰ׷ӵıעڻһflush
+ */
+uint32_t DBFMemoFile::append(const boost::string_view &text) {
+  if (!isOpen() || !mapping_.writable()) {
+    SPDLOG_WARN("Append memo failure : {} is not opened for writing", name_);
+    return 0;
+  }
+
+  uint32_t block = nextBlock_;
+  size_t begin = pending_.readableBytes();
+  if (format_ == kFpt) {
+    appendBig32(pending_, kFptTextType);
+    appendBig32(pending_, static_cast<uint32_t>(text.size()));
+  }
+  pending_.ensureWritableBytes(text.size() + 2);
+  std::memcpy(pending_.beginWrite(), text.data(), text.size());
+  pending_.hasWritten(text.size());
+  if (format_ == kDbt) {
+    pending_.appendChar(kDbtEndFlag);
+    pending_.appendChar(kDbtEndFlag);
+  }
+
+  size_t used = pending_.readableBytes() - begin;
+  size_t blocks = (used + blockBytes_ - 1) / blockBytes_;
+  size_t padding = blocks * blockBytes_ - used;
+  pending_.ensureWritableBytes(padding);
+  std::memset(pending_.beginWrite(), 0, padding);
+  pending_.hasWritten(padding);
+  nextBlock_ += static_cast<uint32_t>(blocks);
+
+  if (pending_.readableBytes() >= kBatchBytes && !flush()) {
+    pending_.unwrite(pending_.readableBytes() - begin);
+    nextBlock_ = block;
+    return 0;
+  }
+  return block;
+}
+
+bool DBFMemoFile::flush() {
+  if (pending_.readableBytes() == 0) {
+    return true;
+  }
+  size_t pos = static_cast<size_t>(flushedBlock_) * blockBytes_;
+  size_t len = pending_.readableBytes();
+  if (!mapping_.resize(pos + len)) {
+    return false;
+  }
+  std::memcpy(mapping_.data() + pos, pending_.peek(), len);
+  mapping_.markDirty(pos, len);
+  pending_.retrieveAll();
+  flushedBlock_ = nextBlock_;
+  writeHeader();
+  return true;
+}
+
+/**
+ * @brief  dbfļõעļչСдdbfļ
+ */
+std::string DBFMemoFile::memoName(const std::string &dbfName, Format format) {
+  std::string ext = format == kDbt ? ".dbt" : ".fpt";
+  auto dot = dbfName.find_last_of('.');
+  auto slash = dbfName.find_last_of("/\\");
+  if (dot == std::string::npos ||
+      (slash != std::string::npos && dot < slash)) {
+    return dbfName + ext;
+  }
+  if (dot + 1 < dbfName.size() &&
+      std::isupper(static_cast<unsigned char>(dbfName[dot + 1]))) {
+    for (auto &ch : ext) {
+      ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+    }
+  }
+  return dbfName.substr(0, dot) + ext;
+}
+
+bool DBFMemoFile::readHeader() {
+  if (mapping_.size() < kHeaderBytes) {
+    SPDLOG_WARN("Memo file header too short : {}", name_);
+    return false;
+  }
+  const char *data = mapping_.data();
+  if (format_ == kFpt) {
+    nextBlock_ = loadBig32(data);
+    uint16_t blockBytes = 0;
+    std::memcpy(&blockBytes, data + 6, sizeof blockBytes);
+    blockBytes = boost::endian::big_to_native(blockBytes);
+    if (blockBytes != 0) {
+      blockBytes_ = blockBytes;
+    }
+  } else {
+    nextBlock_ = loadLittle32(data);
+  }
+  return true;
+}
+
+/**
+ * @brief  dbtļͷһпΪСˣfptΪ˲С
+ */
+void DBFMemoFile::writeHeader() {
+  char *data = mapping_.data();
+  if (format_ == kFpt) {
+    storeBig(data, nextBlock_);
+    storeBig(data + 6, static_cast<uint16_t>(blockBytes_));
+  } else {
+    uint32_t next = boost::endian::native_to_little(nextBlock_);
+    std::memcpy(data, &next, sizeof next);
+    data[16] = 0x03; //dBase IIIעļ汾
+  }
+  mapping_.markDirty(0, 17);
+}
+
+/**
+ * @brief  ȡӳ[pos, pos + len)ݣֻӳԽʱӳ䣬
+ *         Ա׷ӵıע
+ */
+boost::string_view DBFMemoFile::bytesAt(size_t pos, size_t len) {
+  if (pos + len > mapping_.size() && !mapping_.writable()) {
+    mapping_.remap();
+  }
+  if (pos + len > mapping_.size() || (len == 0 && pos >= mapping_.size())) {
+    SPDLOG_WARN("Memo block out of range : {}, pos {}", name_, pos);
+    return boost::string_view();
+  }
+  return boost::string_view(mapping_.data() + pos, len);
+}
+} // namespace dbf
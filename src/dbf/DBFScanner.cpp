@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <cstring>
+
+#include "dbf/DBFFile.h"
+#include "dbf/DBFHead.h"
+#include "dbf/DBFRecord.h"
+#include "dbf/DBFScanner.h"
+#include "dbf/DBFStorage.h"
+
+namespace dbf {
+/**
+ * @brief  ļǰreaderPosʼ˳ɨ赽һ¼
+ *         ֻռchunkBytesСĻӳģʽֱӷӳеļ¼
+ */
+DBFScanner::DBFScanner(DBFFile &file, size_t chunkBytes)
+    : file_(&file), data_(nullptr), chunkPos_(0), chunkLen_(0),
+      pos_(file.readerPos()), end_(file.writerPos()),
+      recordBytes_(static_cast<size_t>(file.head()->recordBytes())),
+      ownSession_(false), started_(false), failed_(false) {
+  if (recordBytes_ == 0 || end_ < pos_) {
+    end_ = pos_;
+    return;
+  }
+
+  if (!file.isMapped()) {
+    size_t records = std::max<size_t>(chunkBytes / recordBytes_, 1);
+    chunk_.resize(records * recordBytes_);
+    if (!file.inSession()) {
+      ownSession_ = file.openSession(true);
+    }
+  }
+  if (file.storage_) {
+    file.storage_->adviseSequential(pos_, end_ - pos_);
+  }
+}
+
+DBFScanner::DBFScanner(DBFScanner &&other)
+    : file_(other.file_), chunk_(std::move(other.chunk_)),
+      data_(other.data_), chunkPos_(other.chunkPos_),
+      chunkLen_(other.chunkLen_), pos_(other.pos_), end_(other.end_),
+      recordBytes_(other.recordBytes_), buf_(std::move(other.buf_)),
+      ownSession_(other.ownSession_), started_(other.started_),
+      failed_(other.failed_) {
+  if (data_ != nullptr && !file_->isMapped()) {
+    data_ = chunk_.data();
+  }
+  if (other.view_.valid()) {
+    view_ = DBFRecordView(data_ + (pos_ - chunkPos_), &file_->layout(), pos_);
+  }
+  other.ownSession_ = false;
+}
+
+DBFScanner::~DBFScanner() {
+  if (ownSession_) {
+    file_->closeSession();
+  }
+}
+
+DBFScanner::iterator DBFScanner::begin() {
+  if (!started_ && !next()) {
+    return end();
+  }
+  return view_.valid() ? iterator(this) : end();
+}
+
+bool DBFScanner::parse(DBFRecord &record) {
+  buf_.retrieveAll();
+  buf_.ensureWritableBytes(recordBytes_);
+  std::memcpy(buf_.beginWrite(), view_.data(), recordBytes_);
+  buf_.hasWritten(recordBytes_);
+  if (!file_->parseRecord(record, buf_, view_.readPos())) {
+    return false;
+  }
+  record.setReadPos(view_.readPos());
+  return true;
+}
+
+bool DBFScanner::next() {
+  if (started_) {
+    pos_ += recordBytes_;
+  }
+  started_ = true;
+  view_ = DBFRecordView();
+
+  if (pos_ + recordBytes_ > end_) {
+    return false;
+  }
+  if (data_ == nullptr || pos_ + recordBytes_ > chunkPos_ + chunkLen_) {
+    if (!fill(pos_)) {
+      failed_ = true;
+      return false;
+    }
+  }
+  view_ = DBFRecordView(data_ + (pos_ - chunkPos_), &file_->layout(), pos_);
+  return true;
+}
+
+bool DBFScanner::fill(size_t pos) {
+  size_t len = end_ - pos;
+  if (file_->isMapped()) {
+    data_ = file_->storage_->data(pos, len);
+  } else {
+    len = std::min(len, chunk_.size());
+    len -= len % recordBytes_;
+    data_ = file_->read(chunk_.data(), static_cast<long>(pos), len)
+                ? chunk_.data()
+                : nullptr;
+    if (data_ != nullptr && file_->storage_) {
+      file_->storage_->adviseWillNeed(pos + len,
+                                      std::min(end_ - pos - len, len));
+    }
+  }
+  if (data_ == nullptr) {
+    return false;
+  }
+  chunkPos_ = pos;
+  chunkLen_ = len;
+  return true;
+}
+} // namespace dbf
@@ -0,0 +1,429 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <stdlib.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include "dbf/DBFStorage.h"
+
+namespace dbf {
+const size_t DBFStreamStorage::kHistoryBytes;
+
+#ifdef _WIN32
+DBFFileStorage::DBFFileStorage() : file_(nullptr) {}
+#else
+DBFFileStorage::DBFFileStorage() : fd_(-1) {}
+#endif
+
+DBFFileStorage::~DBFFileStorage() { close(); }
+
+/**
+ * @brief  ļִ򿪣дʹpread/pwriteÿεöopen/seek/close
+ *
+ * @param readOnly Ƿֻ
+ * @return  򿪳ɹtrueʧܷfalse
+ */
+bool DBFFileStorage::open(const std::string &name, bool readOnly) {
+#ifdef _WIN32
+  file_ = fopen(name.c_str(), readOnly ? "rb" : "rb+");
+  if (file_ == nullptr && !readOnly) {
+    file_ = fopen(name.c_str(), "wb+");
+  }
+  if (file_ == nullptr) {
+    SPDLOG_WARN("Open failure : {}", strerror(errno));
+    return false;
+  }
+#else
+  int flags = readOnly ? O_RDONLY : (O_RDWR | O_CREAT);
+  do {
+    fd_ = ::open(name.c_str(), flags | O_CLOEXEC, 0644);
+  } while (-1 == fd_ && errno == EINTR);
+  if (-1 == fd_) {
+    SPDLOG_WARN("Open failure : {}", strerror(errno));
+    return false;
+  }
+#endif
+  return true;
+}
+
+#ifdef _WIN32
+bool DBFFileStorage::close() {
+  if (file_ == nullptr) {
+    return true;
+  }
+  int result = fclose(file_);
+  file_ = nullptr;
+  if (0 != result) {
+    SPDLOG_WARN("Close failure : {}", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool DBFFileStorage::read(char *buf, size_t len, size_t pos) {
+  if (0 != _fseeki64(file_, static_cast<__int64>(pos), SEEK_SET)) {
+    SPDLOG_WARN("Seek failure : {}", strerror(errno));
+    return false;
+  }
+  if (fread(buf, sizeof(char), len, file_) != len) {
+    SPDLOG_WARN("Read failure : {}", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool DBFFileStorage::write(const char *buf, size_t len, size_t pos) {
+  if (0 != _fseeki64(file_, static_cast<__int64>(pos), SEEK_SET)) {
+    SPDLOG_WARN("Seek failure : {}", strerror(errno));
+    return false;
+  }
+  if (fwrite(buf, sizeof(char), len, file_) != len || 0 != fflush(file_)) {
+    SPDLOG_WARN("Write failure : {}", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool DBFFileStorage::truncate(size_t len) {
+  if (0 != fflush(file_) ||
+      0 != _chsize_s(_fileno(file_), static_cast<__int64>(len))) {
+    SPDLOG_WARN("Truncate failure : {}", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool DBFFileStorage::reserve(size_t) { return true; }
+
+bool DBFFileStorage::sync() {
+  if (0 != fflush(file_) || 0 != _commit(_fileno(file_))) {
+    SPDLOG_WARN("Sync failure : {}", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+int DBFFileStorage::fd() const { return -1; }
+
+void DBFFileStorage::adviseSequential(size_t, size_t) {}
+
+void DBFFileStorage::adviseWillNeed(size_t, size_t) {}
+#else
+bool DBFFileStorage::close() {
+  if (-1 == fd_) {
+    return true;
+  }
+  int result = ::close(fd_);
+  fd_ = -1;
+  if (-1 == result && errno != EINTR) {
+    SPDLOG_WARN("Close failure : {}", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool DBFFileStorage::read(char *buf, size_t len, size_t pos) {
+  while (len > 0) {
+    auto size = ::pread(fd_, buf, len, static_cast<off_t>(pos));
+    if (-1 == size) {
+      if (errno == EINTR) {
+        continue;
+      }
+      SPDLOG_WARN("Read failure : {}", strerror(errno));
+      return false;
+    }
+    if (0 == size) {
+      SPDLOG_WARN("Read failure : unexpected end of file, pos : {}", pos);
+      return false;
+    }
+    buf += size;
+    len -= static_cast<size_t>(size);
+    pos += static_cast<size_t>(size);
+  }
+  return true;
+}
+
+bool DBFFileStorage::write(const char *buf, size_t len, size_t pos) {
+  while (len > 0) {
+    auto size = ::pwrite(fd_, buf, len, static_cast<off_t>(pos));
+    if (-1 == size) {
+      if (errno == EINTR) {
+        continue;
+      }
+      SPDLOG_WARN("Write failure : {}", strerror(errno));
+      return false;
+    }
+    buf += size;
+    len -= static_cast<size_t>(size);
+    pos += static_cast<size_t>(size);
+  }
+  return true;
+}
+
+bool DBFFileStorage::truncate(size_t len) {
+  if (0 != ::ftruncate(fd_, static_cast<off_t>(len))) {
+    SPDLOG_WARN("Truncate failure : {}", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief  Ԥȷ̿鵫ıļСļβĽ־λòӰ죻
+ *         ļϵͳ֧ʱ
+ */
+bool DBFFileStorage::reserve(size_t len) {
+#ifdef FALLOC_FL_KEEP_SIZE
+  int result = 0;
+  do {
+    result = ::fallocate(fd_, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(len));
+  } while (-1 == result && errno == EINTR);
+  if (-1 == result && errno != EOPNOTSUPP && errno != ENOSYS) {
+    SPDLOG_WARN("Fallocate failure : {}", strerror(errno));
+    return false;
+  }
+#else
+  (void)len;
+#endif
+  return true;
+}
+
+bool DBFFileStorage::sync() {
+  if (0 != fsync(fd_)) {
+    SPDLOG_WARN("Fsync failure : {}", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+int DBFFileStorage::fd() const { return fd_; }
+
+void DBFFileStorage::adviseSequential(size_t pos, size_t len) {
+#ifdef POSIX_FADV_SEQUENTIAL
+  posix_fadvise(fd_, static_cast<off_t>(pos), static_cast<off_t>(len),
+                POSIX_FADV_SEQUENTIAL);
+#else
+  (void)pos;
+  (void)len;
+#endif
+}
+
+void DBFFileStorage::adviseWillNeed(size_t pos, size_t len) {
+#ifdef POSIX_FADV_WILLNEED
+  if (len > 0) {
+    posix_fadvise(fd_, static_cast<off_t>(pos), static_cast<off_t>(len),
+                  POSIX_FADV_WILLNEED);
+  }
+#else
+  (void)pos;
+  (void)len;
+#endif
+}
+#endif
+
+bool DBFMapStorage::open(const std::string &name, bool writable) {
+  return mapping_.open(name, writable);
+}
+
+bool DBFMapStorage::read(char *buf, size_t len, size_t pos) {
+  auto src = data(pos, len);
+  if (src == nullptr) {
+    return false;
+  }
+  std::memcpy(buf, src, len);
+  return true;
+}
+
+/**
+ * @brief  дӳֱӿӳļβʱ󲽳չӳ
+ */
+bool DBFMapStorage::write(const char *buf, size_t len, size_t pos) {
+  if (pos + len > mapping_.size() && !mapping_.resize(pos + len)) {
+    return false;
+  }
+  std::memcpy(mapping_.data() + pos, buf, len);
+  mapping_.markDirty(pos, len);
+  return true;
+}
+
+bool DBFMapStorage::truncate(size_t len) { return mapping_.resize(len); }
+
+bool DBFMapStorage::reserve(size_t len) {
+  size_t size = mapping_.size();
+  return len <= mapping_.capacity() ||
+         (mapping_.resize(len) && mapping_.resize(size));
+}
+
+const char *DBFMapStorage::data(size_t pos, size_t len) {
+  if (pos + len > mapping_.size() && !mapping_.remap()) {
+    return nullptr;
+  }
+  if (pos + len > mapping_.size()) {
+    SPDLOG_WARN("Read failure : out of mapping, pos : {}, len : {}, size : {}",
+                pos, len, mapping_.size());
+    return nullptr;
+  }
+  return mapping_.data() + pos;
+}
+
+DBFMemoryStorage::DBFMemoryStorage() : borrowed_(nullptr), borrowedLen_(0) {}
+
+DBFMemoryStorage::DBFMemoryStorage(std::vector<char> bytes)
+    : bytes_(std::move(bytes)), borrowed_(nullptr), borrowedLen_(0) {}
+
+/**
+ * @brief  ֱڵ÷еڴϽֻ
+ */
+DBFMemoryStorage::DBFMemoryStorage(const char *data, size_t len)
+    : borrowed_(data), borrowedLen_(len) {}
+
+bool DBFMemoryStorage::read(char *buf, size_t len, size_t pos) {
+  auto src = data(pos, len);
+  if (src == nullptr) {
+    return false;
+  }
+  std::memcpy(buf, src, len);
+  return true;
+}
+
+bool DBFMemoryStorage::write(const char *buf, size_t len, size_t pos) {
+  if (borrowed_ != nullptr) {
+    SPDLOG_WARN("Write failure : memory storage is read only");
+    return false;
+  }
+  if (pos + len > bytes_.size()) {
+    bytes_.resize(pos + len);
+  }
+  std::memcpy(bytes_.data() + pos, buf, len);
+  return true;
+}
+
+bool DBFMemoryStorage::truncate(size_t len) {
+  if (borrowed_ != nullptr) {
+    SPDLOG_WARN("Truncate failure : memory storage is read only");
+    return false;
+  }
+  bytes_.resize(len);
+  return true;
+}
+
+bool DBFMemoryStorage::reserve(size_t len) {
+  if (borrowed_ == nullptr) {
+    bytes_.reserve(len);
+  }
+  return true;
+}
+
+const char *DBFMemoryStorage::data(size_t pos, size_t len) {
+  const char *base = borrowed_ != nullptr ? borrowed_ : bytes_.data();
+  size_t size = borrowed_ != nullptr ? borrowedLen_ : bytes_.size();
+  if (pos + len > size) {
+    SPDLOG_WARN("Read failure : out of memory storage, pos : {}, len : {}, "
+                "size : {}",
+                pos, len, size);
+    return nullptr;
+  }
+  return base + pos;
+}
+
+DBFStreamStorage::DBFStreamStorage(std::istream &in)
+    : in_(&in), out_(nullptr), pos_(0) {}
+
+/**
+ * @brief  ֻ˳дֻ֧writeHead׷ӡǼ¼Ҫдļͷе
+ *         ¼DBFFileֱӾܾҪűдʱд
+ *         DBFMemoryStorageٰbytes()д
+ */
+DBFStreamStorage::DBFStreamStorage(std::ostream &out)
+    : in_(nullptr), out_(&out), pos_(0) {}
+
+/**
+ * @brief  ɻ˵ֻ˳ͷkHistoryBytesֽڻᱣ
+ *         Աļͷظȡ
+ */
+bool DBFStreamStorage::read(char *buf, size_t len, size_t pos) {
+  if (in_ == nullptr) {
+    SPDLOG_WARN("Read failure : stream storage is write only");
+    return false;
+  }
+  if (pos < history_.size()) {
+    size_t size = std::min(len, history_.size() - pos);
+    std::memcpy(buf, history_.data() + pos, size);
+    buf += size;
+    len -= size;
+    pos += size;
+  }
+  if (len == 0) {
+    return true;
+  }
+  if (pos < pos_) {
+    SPDLOG_WARN("Read failure : stream is not seekable, pos : {}, current : {}",
+                pos, pos_);
+    return false;
+  }
+
+  char skip[4096];
+  while (pos_ < pos) {
+    if (!fetch(skip, std::min(sizeof skip, pos - pos_))) {
+      return false;
+    }
+  }
+  return fetch(buf, len);
+}
+
+bool DBFStreamStorage::write(const char *buf, size_t len, size_t pos) {
+  if (out_ == nullptr) {
+    SPDLOG_WARN("Write failure : stream storage is read only");
+    return false;
+  }
+  if (pos != pos_) {
+    SPDLOG_WARN("Write failure : stream is not seekable, pos : {}, current : {}",
+                pos, pos_);
+    return false;
+  }
+  if (!out_->write(buf, static_cast<std::streamsize>(len))) {
+    SPDLOG_WARN("Write failure : stream error");
+    return false;
+  }
+  pos_ += len;
+  return true;
+}
+
+bool DBFStreamStorage::truncate(size_t len) {
+  if (len != pos_) {
+    SPDLOG_WARN("Truncate failure : stream is not seekable");
+    return false;
+  }
+  return true;
+}
+
+bool DBFStreamStorage::sync() {
+  if (out_ != nullptr && !out_->flush()) {
+    SPDLOG_WARN("Sync failure : stream error");
+    return false;
+  }
+  return true;
+}
+
+bool DBFStreamStorage::fetch(char *buf, size_t len) {
+  if (!in_->read(buf, static_cast<std::streamsize>(len))) {
+    SPDLOG_WARN("Read failure : unexpected end of stream, pos : {}", pos_);
+    return false;
+  }
+  if (pos_ < kHistoryBytes) {
+    size_t size = std::min(len, kHistoryBytes - pos_);
+    history_.insert(history_.end(), buf, buf + size);
+  }
+  pos_ += len;
+  return true;
+}
+} // namespace dbf
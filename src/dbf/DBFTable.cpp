@@ -0,0 +1,109 @@
+#include "dbf/DBFTable.h"
+
+namespace dbf {
+namespace {
+inline char toUpper(char ch) {
+  return ch >= 'a' && ch <= 'z' ? static_cast<char>(ch - 'a' + 'A') : ch;
+}
+} // namespace
+
+const size_t DBFTable::npos;
+
+void DBFTable::reset(const std::vector<DBFHeadField> &fields) {
+  fields_ = fields;
+  layout_.reset(fields_);
+  kinds_.clear();
+  kinds_.reserve(fields_.size());
+  for (auto &field : fields_) {
+    kinds_.push_back(kindOf(field));
+  }
+
+  //λȡСֶ2ݣװʲһ
+  size_t capacity = 8;
+  while (capacity < fields_.size() * 2) {
+    capacity <<= 1;
+  }
+  slots_.assign(capacity, 0);
+  mask_ = capacity - 1;
+  for (size_t index = 0; index < fields_.size(); ++index) {
+    boost::string_view name(fields_[index].name());
+    size_t slot = hash(name) & mask_;
+    while (slots_[slot] != 0) {
+      if (equals(fields_[slots_[slot] - 1].name(), name)) {
+        break; //ֶΰһΪ׼
+      }
+      slot = (slot + 1) & mask_;
+    }
+    if (slots_[slot] == 0) {
+      slots_[slot] = static_cast<uint16_t>(index + 1);
+    }
+  }
+}
+
+size_t DBFTable::indexOf(const boost::string_view &name) const {
+  if (slots_.empty()) {
+    return npos;
+  }
+  size_t slot = hash(name) & mask_;
+  while (slots_[slot] != 0) {
+    size_t index = slots_[slot] - 1;
+    if (equals(fields_[index].name(), name)) {
+      return index;
+    }
+    slot = (slot + 1) & mask_;
+  }
+  return npos;
+}
+
+DBFTable::Kind DBFTable::kindOf(const DBFHeadField &field) {
+  char type = field.filedType().empty() ? '\0' : field.filedType()[0];
+  switch (type) {
+  case 'C':
+    return kString;
+  case 'N':
+  case 'F':
+    return field.precisionLen() > 0 ? kDecimal : kInteger;
+  case 'D':
+    return kDate;
+  case 'L':
+    return kLogical;
+  case 'M':
+  case 'G':
+  case 'P':
+    return kMemo;
+  case 'I':
+    return kBinaryInt;
+  case 'B':
+    return kBinaryDouble;
+  case 'Y':
+    return kCurrency;
+  case 'T':
+    return kDateTime;
+  default:
+    return kUnknown;
+  }
+}
+
+// FNV-1aдĸ
+size_t DBFTable::hash(const boost::string_view &name) {
+  uint32_t value = 2166136261u;
+  for (char ch : name) {
+    value ^= static_cast<unsigned char>(toUpper(ch));
+    value *= 16777619u;
+  }
+  return value;
+}
+
+bool DBFTable::equals(const boost::string_view &lhs,
+                      const boost::string_view &rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t index = 0; index < lhs.size(); ++index) {
+    if (toUpper(lhs[index]) != toUpper(rhs[index])) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace dbf
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <boost/utility/string_view.hpp>
+#include <spdlog/spdlog.h>
+
+#include "dbf/util/StringUtil.hpp"
+
+// 用法：bench_format [每种字段的值个数]
+// 对比appendInt改写前后的两种格式化方式：
+//   旧路径：intToFloatStringView逐位除模写到视图尾部，再memmove到位、memset补空格
+//   新路径：formatDecimal查表每次写两位，直接写满字段
+
+namespace {
+template <size_t FieldLen, size_t PrecisionSize, typename T>
+void formatOld(char *dst, T val) {
+  boost::string_view view(dst, FieldLen);
+  util::intToFloatStringView<FieldLen, PrecisionSize, T>(val, view);
+  if (FieldLen > view.size()) {
+    std::memmove(dst + FieldLen - view.size(), view.data(), view.size());
+    std::memset(dst, ' ', FieldLen - view.size());
+  }
+}
+
+template <size_t FieldLen, size_t PrecisionSize, typename T>
+void formatNew(char *dst, T val) {
+  util::formatDecimal(dst, FieldLen, PrecisionSize, val);
+}
+
+template <typename Format>
+double measure(Format format, const std::vector<int64_t> &values,
+               std::vector<char> &out, size_t fieldLen) {
+  auto begin = std::chrono::steady_clock::now();
+  char *dst = out.data();
+  for (auto value : values) {
+    format(dst, value);
+    dst += fieldLen;
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - begin).count() /
+         static_cast<double>(values.size());
+}
+
+// 生成能放进N(FieldLen,PrecisionSize)的值，位数均匀分布，正负各半
+template <size_t FieldLen, size_t PrecisionSize>
+std::vector<int64_t> makeValues(size_t count) {
+  size_t maxDigits = FieldLen - (PrecisionSize > 0 ? 1 : 0) - 1;
+  if (maxDigits > 18) {
+    maxDigits = 18;
+  }
+  std::mt19937_64 gen(20240101);
+  std::vector<int64_t> values(count);
+  for (auto &value : values) {
+    size_t digits = 1 + gen() % maxDigits;
+    int64_t bound = 1;
+    for (size_t i = 0; i < digits; ++i) {
+      bound *= 10;
+    }
+    value = static_cast<int64_t>(gen() % static_cast<uint64_t>(bound));
+    if (gen() & 1) {
+      value = -value;
+    }
+  }
+  return values;
+}
+
+template <size_t FieldLen, size_t PrecisionSize> bool bench(size_t count) {
+  auto values = makeValues<FieldLen, PrecisionSize>(count);
+  std::vector<char> oldOut(count * FieldLen), newOut(count * FieldLen);
+
+  // 先各跑一遍预热，再取三轮中的最好成绩
+  measure(formatOld<FieldLen, PrecisionSize, int64_t>, values, oldOut,
+          FieldLen);
+  measure(formatNew<FieldLen, PrecisionSize, int64_t>, values, newOut,
+          FieldLen);
+  double oldNs = 1e30, newNs = 1e30;
+  for (int round = 0; round < 3; ++round) {
+    oldNs = std::min(oldNs, measure(formatOld<FieldLen, PrecisionSize, int64_t>,
+                                    values, oldOut, FieldLen));
+    newNs = std::min(newNs, measure(formatNew<FieldLen, PrecisionSize, int64_t>,
+                                    values, newOut, FieldLen));
+  }
+
+  bool same = oldOut == newOut;
+  SPDLOG_INFO("N({},{}) {} values : old {:.1f} ns, new {:.1f} ns, "
+              "speedup {:.2f}x, output {}",
+              FieldLen, PrecisionSize, count, oldNs, newNs, oldNs / newNs,
+              same ? "identical" : "DIFFERENT");
+  return same;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+  bool same = bench<16, 3>(count);
+  same = bench<8, 0>(count) && same;
+  same = bench<12, 2>(count) && same;
+  same = bench<20, 6>(count) && same;
+  return same ? 0 : 1;
+}
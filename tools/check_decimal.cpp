@@ -0,0 +1,135 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "dbf/util/StringUtil.hpp"
+
+// 用法：check_decimal [随机用例个数]
+// 校验decimalToInt与decimalToDouble在19、20位宽字段上的结果：
+//   decimalToDouble与strtod解析截断后文本的结果逐位比较，放大后超出uint64_t时
+//   应当返回false；decimalToInt超出目标类型范围时应当返回false而不是回绕
+
+namespace {
+const uint64_t kMaxMagnitude = UINT64_MAX;
+
+// 按precision截断多余的小数位，得到strtod的输入和放大后的绝对值
+bool truncate(const std::string &field, size_t precision, std::string &text,
+              uint64_t &magnitude) {
+  text.clear();
+  magnitude = 0;
+  bool overflow = false;
+  size_t fracLen = 0;
+  bool inFrac = false;
+  for (char ch : field) {
+    if (ch == ' ') {
+      continue;
+    }
+    if (ch == '.') {
+      inFrac = true;
+    } else if (ch >= '0' && ch <= '9') {
+      if (inFrac && fracLen == precision) {
+        continue;
+      }
+      fracLen += inFrac ? 1 : 0;
+      unsigned digit = static_cast<unsigned>(ch - '0');
+      overflow = overflow || magnitude > (kMaxMagnitude - digit) / 10;
+      magnitude = magnitude * 10 + digit;
+    }
+    text.push_back(ch);
+  }
+  for (; fracLen < precision; ++fracLen) {
+    overflow = overflow || magnitude > kMaxMagnitude / 10;
+    magnitude *= 10;
+  }
+  return !overflow;
+}
+
+bool checkDouble(const std::string &field, size_t precision) {
+  std::string text;
+  uint64_t magnitude = 0;
+  bool expectOk = truncate(field, precision, text, magnitude);
+  double value = 0;
+  bool ok = util::decimalToDouble(field.data(), field.size(), precision, value);
+  double expect = expectOk ? std::strtod(text.c_str(), nullptr) : 0;
+  if (ok != expectOk || (ok && value != expect)) {
+    SPDLOG_ERROR("decimalToDouble('{}', {}) : got {} {:.17g}, expect {} {:.17g}",
+                 field, precision, ok, value, expectOk, expect);
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool checkInt(const char *field, size_t precision, bool expectOk, T expect) {
+  T value = 0;
+  bool ok = util::decimalToInt(field, std::strlen(field), precision, value);
+  if (ok != expectOk || (ok && value != expect)) {
+    SPDLOG_ERROR("decimalToInt('{}', {}) : got {} {}, expect {} {}", field,
+                 precision, ok, value, expectOk, expect);
+    return false;
+  }
+  return true;
+}
+
+// 生成定长字段：digits位数字，随机放一个小数点，正负各半，左侧补空格
+std::string makeField(std::mt19937_64 &gen, size_t digits, size_t len) {
+  std::string body;
+  for (size_t i = 0; i < digits; ++i) {
+    body.push_back(static_cast<char>('0' + gen() % 10));
+  }
+  if (gen() % 4 != 0) {
+    body.insert(gen() % (digits + 1), 1, '.');
+  }
+  if (gen() & 1) {
+    body.insert(0, 1, '-');
+  }
+  return std::string(len > body.size() ? len - body.size() : 0, ' ') + body;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  bool ok = true;
+
+  ok = checkDouble("942554922806.7973592", 7) && ok;
+  ok = checkDouble("-942554922806.7973592", 7) && ok;
+  ok = checkDouble("9999999999999999999", 0) && ok;
+  ok = checkDouble("18446744073709551615", 0) && ok;
+  ok = checkDouble("18446744073709551616", 0) && ok;
+  ok = checkDouble("-99999999999999999999", 0) && ok;
+  ok = checkDouble("1844674407370955161.5", 1) && ok;
+  ok = checkDouble("1844674407370955161.6", 1) && ok;
+  ok = checkDouble("  12345678901234567.89", 2) && ok;
+  ok = checkDouble("  12345678901234567.89", 3) && ok;
+
+  ok = checkInt<int64_t>("99999999999999999999", 0, false, 0) && ok;
+  ok = checkInt<int64_t>("9223372036854775807", 0, true, INT64_MAX) && ok;
+  ok = checkInt<int64_t>("-9223372036854775808", 0, true, INT64_MIN) && ok;
+  ok = checkInt<int64_t>("9223372036854775808", 0, false, 0) && ok;
+  ok = checkInt<uint64_t>("18446744073709551615", 0, true, UINT64_MAX) && ok;
+  ok = checkInt<uint64_t>("18446744073709551616", 0, false, 0) && ok;
+  ok = checkInt<int32_t>("3000000000", 0, false, 0) && ok;
+  ok = checkInt<int32_t>("-2147483648", 0, true, INT32_MIN) && ok;
+  ok = checkInt<uint32_t>("-5", 0, false, 0) && ok;
+
+  std::mt19937_64 gen(20240101);
+  size_t failures = 0;
+  for (size_t i = 0; i < count; ++i) {
+    size_t digits = 19 + gen() % 2;
+    size_t len = digits + 2 + gen() % 4;
+    size_t precision = gen() % 8;
+    if (!checkDouble(makeField(gen, digits, len), precision) &&
+        ++failures >= 10) {
+      break;
+    }
+  }
+  ok = failures == 0 && ok;
+
+  SPDLOG_INFO("{} random 19/20-digit fields : {}", count,
+              ok ? "all match" : "MISMATCH");
+  return ok ? 0 : 1;
+}
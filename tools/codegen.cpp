@@ -0,0 +1,36 @@
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "dbf/DBFCodeGenerator.h"
+#include "dbf/DBFFile.h"
+
+using namespace dbf;
+
+// 用法：codegen <dbf文件> <类名> [输出目录] [命名空间]
+int main(int argc, char *argv[]) {
+  if (argc < 3) {
+    SPDLOG_ERROR("Usage : {} <dbf file> <class name> [output dir] [namespace]",
+                 argv[0]);
+    return 1;
+  }
+  std::string dir = argc > 3 ? argv[3] : ".";
+  std::string nameSpace = argc > 4 ? argv[4] : "dbf";
+
+  DBFFile file(argv[1]);
+  if (!file.readHead()) {
+    SPDLOG_ERROR("Read dbf head failed : {}", argv[1]);
+    return 1;
+  }
+  DBFCodeGenerator generator(argv[2], nameSpace);
+  if (!generator.load(file)) {
+    SPDLOG_ERROR("Unsupported dbf layout : {}", argv[1]);
+    return 1;
+  }
+  if (!generator.writeFiles(dir)) {
+    return 1;
+  }
+  SPDLOG_INFO("Generated {} with {} fields, record bytes {}", argv[2],
+              generator.members().size(), generator.recordBytes());
+  return 0;
+}